@@ -536,7 +536,8 @@ static dispatch_once_t sProxyAppDelegateRemoteNotificationOnceToken;
   static dispatch_once_t onceToken;
   static GULMutableDictionary *sInterceptors;
   dispatch_once(&onceToken, ^{
-    sInterceptors = [[GULMutableDictionary alloc] init];
+    sInterceptors = [[GULMutableDictionary alloc]
+        initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
   });
   return sInterceptors;
 }
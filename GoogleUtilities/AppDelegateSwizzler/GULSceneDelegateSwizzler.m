@@ -177,7 +177,8 @@ static NSString *const kGULSceneDelegatePrefix = @"GUL_";
   static dispatch_once_t onceToken;
   static GULMutableDictionary *sInterceptors;
   dispatch_once(&onceToken, ^{
-    sInterceptors = [[GULMutableDictionary alloc] init];
+    sInterceptors = [[GULMutableDictionary alloc]
+        initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
   });
   return sInterceptors;
 }
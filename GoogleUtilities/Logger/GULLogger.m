@@ -15,8 +15,15 @@
 #import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
 
 #import <os/log.h>
+#import <time.h>
 
 #import "GoogleUtilities/Environment/Public/GoogleUtilities/GULAppEnvironmentUtil.h"
+#import "GoogleUtilities/Logger/GULLoggerBuffer.h"
+#import "GoogleUtilities/Logger/GULLoggerHandleInternal.h"
+#import "GoogleUtilities/Logger/GULLoggerRateLimiter.h"
+#import "GoogleUtilities/Logger/GULLoggerRecordArguments.h"
+#import "GoogleUtilities/Logger/GULLoggerRecordFields.h"
+#import "GoogleUtilities/Logger/GULLoggerSinkInternal.h"
 #import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerLevel.h"
 
 static dispatch_once_t sGULLoggerOnceToken;
@@ -27,6 +34,11 @@ static BOOL sGULLoggerDebugMode;
 
 static GULLoggerLevel sGULLoggerMaximumLevel;
 
+static BOOL sGULLoggerDeferredFormatting;
+
+/// Whether a batch is being passed to the sinks. Only accessed on `sGULClientQueue`.
+static BOOL sGULLoggerWritingToSinks;
+
 // Allow clients to register a version to include in the log.
 static NSString *sVersion = @"";
 
@@ -34,22 +46,28 @@ NSString *const kGULLogSubsystem = @"com.google.utilities.logger";
 
 static GULLoggerService kGULLoggerLogger = @"[GULLogger]";
 
-static NSMutableDictionary<NSString *, NSMutableDictionary<GULLoggerService, os_log_t> *>
-    *sGULServiceLogs;
-
 #ifdef DEBUG
 /// The regex pattern for the message code.
 static NSString *const kMessageCodePattern = @"^I-[A-Z]{3}[0-9]{6}$";
 static NSRegularExpression *sMessageCodeRegex;
 #endif
 
+static void GULLoggerWriteRecords(GULLoggerRecord *records, NSUInteger count);
+
 void GULLoggerInitialize(void) {
   dispatch_once(&sGULLoggerOnceToken, ^{
-    sGULLoggerMaximumLevel = GULLoggerLevelNotice;
-    sGULClientQueue = dispatch_queue_create("GULLoggingClientQueue", DISPATCH_QUEUE_SERIAL);
-    dispatch_set_target_queue(sGULClientQueue,
-                              dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
-    sGULServiceLogs = [NSMutableDictionary dictionary];
+    __atomic_store_n(&sGULLoggerMaximumLevel, GULLoggerLevelNotice, __ATOMIC_RELAXED);
+    GULLoggerHandlesSetGlobalLevel(GULLoggerLevelNotice,
+                                   __atomic_load_n(&sGULLoggerDebugMode, __ATOMIC_RELAXED));
+    // The queue outlives `GULResetLogger`, which re-runs this block, because the thread buffers
+    // keep draining into it.
+    if (!sGULClientQueue) {
+      sGULClientQueue = dispatch_queue_create("GULLoggingClientQueue", DISPATCH_QUEUE_SERIAL);
+      dispatch_set_target_queue(sGULClientQueue,
+                                dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
+      GULLoggerBufferInitialize(sGULClientQueue, GULLoggerWriteRecords);
+      GULLoggerRateLimiterInitialize(sGULClientQueue);
+    }
 #ifdef DEBUG
     sMessageCodeRegex = [NSRegularExpression regularExpressionWithPattern:kMessageCodePattern
                                                                   options:0
@@ -61,46 +79,93 @@ void GULLoggerInitialize(void) {
 void GULLoggerForceDebug(void) {
   // We should enable debug mode if we're not running from App Store.
   if (![GULAppEnvironmentUtil isFromAppStore]) {
-    sGULLoggerDebugMode = YES;
+    __atomic_store_n(&sGULLoggerDebugMode, YES, __ATOMIC_RELAXED);
     GULSetLoggerLevel(GULLoggerLevelDebug);
   }
 }
 
 GULLoggerLevel GULGetLoggerLevel(void) {
-  return sGULLoggerMaximumLevel;
+  return __atomic_load_n(&sGULLoggerMaximumLevel, __ATOMIC_RELAXED);
 }
 
-__attribute__((no_sanitize("thread"))) void GULSetLoggerLevel(GULLoggerLevel loggerLevel) {
+/// Returns NO, logging an error, if `loggerLevel` is out of range, and NO if it may not be set
+/// because the app is running from the App Store.
+static BOOL GULLoggerCanSetLevel(GULLoggerLevel loggerLevel) {
   if (loggerLevel < GULLoggerLevelMin || loggerLevel > GULLoggerLevelMax) {
     GULOSLogError(kGULLogSubsystem, kGULLoggerLogger, YES, @"I-COR000023",
                   @"Invalid logger level, %ld", (long)loggerLevel);
-    return;
+    return NO;
   }
   GULLoggerInitialize();
   // We should not raise the logger level if we are running from App Store.
-  if (loggerLevel >= GULLoggerLevelNotice && [GULAppEnvironmentUtil isFromAppStore]) {
+  return !(loggerLevel >= GULLoggerLevelNotice && [GULAppEnvironmentUtil isFromAppStore]);
+}
+
+void GULSetLoggerLevel(GULLoggerLevel loggerLevel) {
+  if (!GULLoggerCanSetLevel(loggerLevel)) {
     return;
   }
 
-  sGULLoggerMaximumLevel = loggerLevel;
+  __atomic_store_n(&sGULLoggerMaximumLevel, loggerLevel, __ATOMIC_RELAXED);
+  GULLoggerHandlesSetGlobalLevel(loggerLevel,
+                                 __atomic_load_n(&sGULLoggerDebugMode, __ATOMIC_RELAXED));
+}
+
+void GULLoggerHandleSetLevel(GULLoggerHandle *handle, GULLoggerLevel loggerLevel) {
+  if (!GULLoggerCanSetLevel(loggerLevel)) {
+    return;
+  }
+
+  GULLoggerHandleSetLevelOverride(handle, (int)loggerLevel);
+}
+
+void GULLoggerSetCategoryLevel(NSString *subsystem,
+                               NSString *category,
+                               GULLoggerLevel loggerLevel) {
+  GULLoggerHandleSetLevel(GULLoggerRegisterHandle(subsystem, category), loggerLevel);
+}
+
+void GULLoggerClearCategoryLevel(NSString *subsystem, NSString *category) {
+  // A category without a handle has no level to clear.
+  GULLoggerHandle *handle = GULLoggerExistingHandle(subsystem, category);
+  if (handle) {
+    GULLoggerHandleSetLevelOverride(handle, 0);
+  }
 }
 
 /**
  * Check if the level is high enough to be loggable.
  */
-__attribute__((no_sanitize("thread"))) BOOL GULIsLoggableLevel(GULLoggerLevel loggerLevel) {
+BOOL GULIsLoggableLevel(GULLoggerLevel loggerLevel) {
   GULLoggerInitialize();
-  if (sGULLoggerDebugMode) {
+  if (__atomic_load_n(&sGULLoggerDebugMode, __ATOMIC_RELAXED)) {
     return YES;
   }
-  return (BOOL)(loggerLevel <= sGULLoggerMaximumLevel);
+  return (BOOL)(loggerLevel <= __atomic_load_n(&sGULLoggerMaximumLevel, __ATOMIC_RELAXED));
+}
+
+/// Returns whether `level` is logged for a category, looking up its level override, if any,
+/// without taking a lock.
+static BOOL GULIsLoggableLevelForCategory(GULLoggerLevel level,
+                                          NSString *subsystem,
+                                          NSString *category) {
+  if (__atomic_load_n(&sGULLoggerDebugMode, __ATOMIC_RELAXED)) {
+    return YES;
+  }
+  int levelOverride = GULLoggerLevelOverride(subsystem, category);
+  if (levelOverride) {
+    return (int)level <= levelOverride;
+  }
+  return level <= __atomic_load_n(&sGULLoggerMaximumLevel, __ATOMIC_RELAXED);
 }
 
 #ifdef DEBUG
 void GULResetLogger(void) {
   sGULLoggerOnceToken = 0;
-  sGULLoggerDebugMode = NO;
-  sGULLoggerMaximumLevel = GULLoggerLevelNotice;
+  __atomic_store_n(&sGULLoggerDebugMode, NO, __ATOMIC_RELAXED);
+  __atomic_store_n(&sGULLoggerMaximumLevel, GULLoggerLevelNotice, __ATOMIC_RELAXED);
+  GULLoggerHandlesSetGlobalLevel(GULLoggerLevelNotice, NO);
+  GULLoggerHandlesClearLevelOverrides();
 }
 
 dispatch_queue_t getGULClientQueue(void) {
@@ -108,10 +173,22 @@ dispatch_queue_t getGULClientQueue(void) {
 }
 
 BOOL getGULLoggerDebugMode(void) {
-  return sGULLoggerDebugMode;
+  return __atomic_load_n(&sGULLoggerDebugMode, __ATOMIC_RELAXED);
 }
 #endif
 
+void GULLoggerSetDeferredFormatting(BOOL deferredFormatting) {
+  sGULLoggerDeferredFormatting = deferredFormatting;
+}
+
+void GULLoggerFlush(void) {
+  GULLoggerInitialize();
+  GULLoggerBufferFlush();
+  GULLoggerBufferPerformOnDrainQueue(^{
+    GULLoggerFlushSinks();
+  });
+}
+
 void GULLoggerRegisterVersion(NSString *version) {
   sVersion = version;
 }
@@ -130,6 +207,36 @@ os_log_type_t GULLoggerLevelToOSLogType(GULLoggerLevel level) {
   }
 }
 
+/// Stamps `record`, which already has its level, origin and message, with the time and
+/// `messageCode`, and hands it to the calling thread's buffer.
+static void GULLoggerSubmitRecord(GULLoggerRecord *record, NSString *messageCode) {
+#ifdef DEBUG
+  NSCAssert(messageCode.length == 11, @"Incorrect message code length.");
+  NSRange messageCodeRange = NSMakeRange(0, messageCode.length);
+  NSUInteger __unused numberOfMatches =
+      [sMessageCodeRegex numberOfMatchesInString:messageCode options:0 range:messageCodeRange];
+  NSCAssert(numberOfMatches == 1, @"Incorrect message code format.");
+#endif
+  record->timestamp = clock_gettime_nsec_np(CLOCK_REALTIME);
+  record->messageCode = CFBridgingRetain([messageCode copy]);
+  GULLoggerBufferEnqueue(record);
+}
+
+/// Fills in the message of `record`, which already has its level and origin, and submits it.
+static void GULLoggerEnqueueRecord(GULLoggerRecord *record,
+                                   NSString *messageCode,
+                                   NSString *message,
+                                   va_list args_ptr) {
+  if (args_ptr == NULL) {
+    record->message = CFBridgingRetain([message copy]);
+  } else if (!sGULLoggerDeferredFormatting ||
+             !GULLoggerRecordCaptureArguments(record, message, args_ptr)) {
+    NSString *logMsg = [[NSString alloc] initWithFormat:message arguments:args_ptr];
+    record->message = CFBridgingRetain(logMsg);
+  }
+  GULLoggerSubmitRecord(record, messageCode);
+}
+
 void GULOSLogBasic(GULLoggerLevel level,
                    NSString *subsystem,
                    NSString *category,
@@ -138,39 +245,111 @@ void GULOSLogBasic(GULLoggerLevel level,
                    NSString *message,
                    va_list args_ptr) {
   GULLoggerInitialize();
-  if (!(level <= sGULLoggerMaximumLevel || sGULLoggerDebugMode || forceLog)) {
+  if (!(forceLog || GULIsLoggableLevelForCategory(level, subsystem, category)) ||
+      !GULLoggerRateLimiterShouldLog(messageCode)) {
     return;
   }
 
-#ifdef DEBUG
-  NSCAssert(messageCode.length == 11, @"Incorrect message code length.");
-  NSRange messageCodeRange = NSMakeRange(0, messageCode.length);
-  NSUInteger __unused numberOfMatches =
-      [sMessageCodeRegex numberOfMatchesInString:messageCode options:0 range:messageCodeRange];
-  NSCAssert(numberOfMatches == 1, @"Incorrect message code format.");
-#endif
-  NSString *logMsg;
-  if (args_ptr == NULL) {
-    logMsg = message;
-  } else {
-    logMsg = [[NSString alloc] initWithFormat:message arguments:args_ptr];
-  }
-  logMsg = [NSString stringWithFormat:@"%@ - %@[%@] %@", sVersion, category, messageCode, logMsg];
-  dispatch_async(sGULClientQueue, ^{
-    NSMutableDictionary<GULLoggerService, os_log_t> *subsystemLogs = sGULServiceLogs[subsystem];
-    if (!subsystemLogs) {
-      subsystemLogs = [NSMutableDictionary dictionary];
-      sGULServiceLogs[subsystem] = subsystemLogs;
+  GULLoggerRecord record = {
+      .level = level,
+      .subsystem = CFBridgingRetain([subsystem copy]),
+      .category = CFBridgingRetain([category copy]),
+  };
+  GULLoggerEnqueueRecord(&record, messageCode, message, args_ptr);
+}
+
+void GULLoggerLogBasic(GULLoggerHandle *handle,
+                       GULLoggerLevel level,
+                       BOOL forceLog,
+                       NSString *messageCode,
+                       NSString *message,
+                       va_list args_ptr) {
+  GULLoggerInitialize();
+  if (!(GULLoggerHandleIsLoggable(handle, level) || forceLog) ||
+      !GULLoggerRateLimiterShouldLog(messageCode)) {
+    return;
+  }
+
+  GULLoggerRecord record = {.level = level, .handle = handle};
+  GULLoggerEnqueueRecord(&record, messageCode, message, args_ptr);
+}
+
+void GULLoggerLogFields(GULLoggerHandle *handle,
+                        GULLoggerLevel level,
+                        BOOL force,
+                        NSString *messageCode,
+                        NSString *message,
+                        const GULLoggerField *fields,
+                        NSUInteger fieldCount) {
+  GULLoggerInitialize();
+  if (!(GULLoggerHandleIsLoggable(handle, level) || force) ||
+      !GULLoggerRateLimiterShouldLog(messageCode)) {
+    GULLoggerFieldsRelease(fields, fieldCount);
+    return;
+  }
+
+  GULLoggerRecord record = {
+      .level = level,
+      .handle = handle,
+      .message = CFBridgingRetain([message copy]),
+  };
+  GULLoggerRecordTakeFields(&record, fields, fieldCount);
+  GULLoggerSubmitRecord(&record, messageCode);
+}
+
+/// Writes a batch of buffered records to os_log and passes them on to the sinks, formatting
+/// deferred messages. Runs on `sGULClientQueue`.
+static void GULLoggerWriteRecords(GULLoggerRecord *records, NSUInteger count) {
+  @autoreleasepool {
+    // Records logged by a sink are handled inline, and must not reach the sinks again.
+    NSArray<id<GULLoggerSink>> *sinks = sGULLoggerWritingToSinks ? nil : GULLoggerCurrentSinks();
+    NSMutableArray<GULLoggerSinkRecord *> *sinkRecords =
+        sinks ? [NSMutableArray arrayWithCapacity:count] : nil;
+    for (NSUInteger i = 0; i < count; i++) {
+      GULLoggerRecord *record = &records[i];
+      const GULLoggerHandle *handle = record->handle;
+      if (!handle) {
+        handle = GULLoggerImplicitHandle((__bridge NSString *)record->subsystem,
+                                         (__bridge NSString *)record->category);
+      }
+      NSString *subsystem = (__bridge NSString *)(handle ? handle->subsystem : record->subsystem);
+      NSString *category = (__bridge NSString *)(handle ? handle->category : record->category);
+      // Categories beyond the registry's cap get a log object for this message only.
+      os_log_t log = handle ? (__bridge os_log_t)handle->log
+                            : os_log_create(subsystem.UTF8String, category.UTF8String);
+      NSString *message = GULLoggerRecordMessage(record);
+      NSDictionary<NSString *, id> *fields = GULLoggerRecordFields(record);
+      NSString *logMsg = [NSString stringWithFormat:@"%@ - %@[%@] %@%@", sVersion, category,
+                                                    (__bridge NSString *)record->messageCode,
+                                                    message, GULLoggerFieldsDescription(fields)];
+      os_log_with_type(log, GULLoggerLevelToOSLogType(record->level), "%{public}@", logMsg);
+      [sinkRecords addObject:[[GULLoggerSinkRecord alloc]
+                                 initWithLevel:record->level
+                                     timestamp:record->timestamp
+                                     subsystem:subsystem
+                                      category:category
+                                   messageCode:(__bridge NSString *)record->messageCode
+                                       message:message
+                                        fields:fields]];
+      GULLoggerRecordRelease(record);
     }
 
-    os_log_t serviceLog = [subsystemLogs objectForKey:subsystem];
-    if (!serviceLog) {
-      serviceLog = os_log_create(subsystem.UTF8String, category.UTF8String);
-      subsystemLogs[category] = serviceLog;
+    if (sinks) {
+      sGULLoggerWritingToSinks = YES;
+      for (id<GULLoggerSink> sink in sinks) {
+        [sink writeRecords:sinkRecords];
+      }
+      sGULLoggerWritingToSinks = NO;
     }
+  }
 
-    os_log_with_type(serviceLog, GULLoggerLevelToOSLogType(level), "%{public}@", logMsg);
-  });
+  uint64_t droppedCount = GULLoggerBufferTakeRecentDropCount();
+  if (droppedCount > 0) {
+    // Logged from the drain queue, so it is written immediately rather than buffered.
+    GULOSLogWarning(kGULLogSubsystem, kGULLoggerLogger, YES, @"I-COR000024",
+                    @"%llu log messages were dropped because the log buffer was full.",
+                    droppedCount);
+  }
 }
 
 /**
@@ -199,6 +378,23 @@ GUL_LOGGING_FUNCTION(Debug)
 
 #undef GUL_LOGGING_FUNCTION
 
+#define GUL_HANDLE_LOGGING_FUNCTION(level)                                                         \
+  void GULLoggerLog##level(GULLoggerHandle *handle, BOOL force, NSString *messageCode,             \
+                           NSString *message, ...) {                                               \
+    va_list args_ptr;                                                                              \
+    va_start(args_ptr, message);                                                                   \
+    GULLoggerLogBasic(handle, GULLoggerLevel##level, force, messageCode, message, args_ptr);       \
+    va_end(args_ptr);                                                                              \
+  }
+
+GUL_HANDLE_LOGGING_FUNCTION(Error)
+GUL_HANDLE_LOGGING_FUNCTION(Warning)
+GUL_HANDLE_LOGGING_FUNCTION(Notice)
+GUL_HANDLE_LOGGING_FUNCTION(Info)
+GUL_HANDLE_LOGGING_FUNCTION(Debug)
+
+#undef GUL_HANDLE_LOGGING_FUNCTION
+
 #pragma mark - GULLoggerWrapper
 
 @implementation GULLoggerWrapper
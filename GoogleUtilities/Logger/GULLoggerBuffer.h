@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerFields.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The format and captured arguments of a message formatted on the drain queue; see
+/// `GULLoggerRecordCaptureArguments`.
+typedef struct GULLoggerCapturedArguments GULLoggerCapturedArguments;
+
+/// A log record on its way from the logging thread to the drain queue. The object fields hold
+/// references retained with `CFBridgingRetain`; ownership moves with the record into the buffer and
+/// on to the record handler, which must release them with `GULLoggerRecordRelease`.
+///
+/// Records logged through a registered handle refer to it instead of holding their subsystem and
+/// category.
+///
+/// A record holds either the formatted `message`, or `arguments` captured out of line by
+/// `GULLoggerRecordCaptureArguments`, which are formatted on demand by `GULLoggerRecordMessage`.
+/// Records logged with `GULLoggerLogFields` also hold a copy of their fields, made by
+/// `GULLoggerRecordTakeFields`.
+typedef struct {
+  GULLoggerLevel level;
+  uint64_t timestamp;  // Nanoseconds since 1970
+  const GULLoggerHandle *_Nullable handle;
+  CFTypeRef subsystem;    // NSString
+  CFTypeRef category;     // NSString
+  CFTypeRef messageCode;  // NSString
+  CFTypeRef message;      // NSString, formatted but without the version/category/code prefix
+  GULLoggerCapturedArguments *_Nullable arguments;
+  GULLoggerField *_Nullable fields;
+  uint8_t fieldCount;
+} GULLoggerRecord;
+
+/// Releases the object references held by `record`.
+void GULLoggerRecordRelease(GULLoggerRecord *record);
+
+/// Handles a batch of records on the drain queue, taking ownership of them.
+typedef void (*GULLoggerRecordHandler)(GULLoggerRecord *records, NSUInteger count);
+
+/// Sets up the per-thread buffers, which are drained on `drainQueue` by passing their records to
+/// `handler`. Subsequent calls have no effect.
+void GULLoggerBufferInitialize(dispatch_queue_t drainQueue, GULLoggerRecordHandler handler);
+
+/// Moves `record` into the calling thread's buffer and schedules a drain. If the buffer is full,
+/// the record is released and counted as dropped, or the call waits for room, depending on the
+/// buffer policy. Records logged from the drain queue itself are handled immediately, and records
+/// logged on the draining thread from another queue are dropped rather than waited for.
+void GULLoggerBufferEnqueue(GULLoggerRecord *record);
+
+/// Waits until every record enqueued before the call has been handled. Called while draining,
+/// e.g. by a sink, it returns immediately and the drain in progress handles those records.
+void GULLoggerBufferFlush(void);
+
+/// Runs `block` on the drain queue and waits for it, so that it never overlaps with handling a
+/// batch. Runs it immediately if called from the drain queue.
+void GULLoggerBufferPerformOnDrainQueue(dispatch_block_t block);
+
+/// Returns the number of records dropped since the last call, and resets the count. Called on the
+/// drain queue to report drops.
+uint64_t GULLoggerBufferTakeRecentDropCount(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,290 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerBuffer.h"
+
+#import <os/lock.h>
+#import <pthread.h>
+#import <unistd.h>
+
+#import "GoogleUtilities/Logger/GULLoggerRecordArguments.h"
+#import "GoogleUtilities/Logger/GULLoggerRecordFields.h"
+
+/// The number of records a thread buffer holds unless changed with `GULLoggerSetBufferCapacity`.
+static const NSUInteger kGULLoggerBufferDefaultCapacity = 256;
+
+/// The number of records moved out of a buffer at a time before they are handled, so that the
+/// producer can reuse the slots while the batch is written to the log.
+enum { kGULLoggerBufferDrainBatchSize = 64 };
+
+/// How long a producer waits for the drain queue to make room under `GULLoggerBufferPolicyBlock`.
+static const useconds_t kGULLoggerBufferBlockBackoff = 100;
+
+/// A single-producer, single-consumer ring of records. The owning thread is the only writer of
+/// `tail` and the drain queue the only writer of `head`, so neither side needs a lock.
+typedef struct GULLoggerThreadBuffer {
+  /// The next buffer in `sGULLoggerBuffers`; guarded by `sGULLoggerBuffersLock`.
+  struct GULLoggerThreadBuffer *next;
+  /// The number of records read; written by the drain queue.
+  uint64_t head;
+  /// The number of records written; written by the owning thread.
+  uint64_t tail;
+  /// Set once the owning thread has exited; the drain queue frees the buffer once it is empty.
+  BOOL abandoned;
+  /// The capacity minus one; the capacity is a power of two.
+  uint64_t mask;
+  GULLoggerRecord records[];
+} GULLoggerThreadBuffer;
+
+static dispatch_queue_t sGULLoggerBufferQueue;
+
+static GULLoggerRecordHandler sGULLoggerBufferHandler;
+
+/// Coalesces drain requests from all producers into one pending drain.
+static dispatch_source_t sGULLoggerBufferDrainSource;
+
+/// Marks `sGULLoggerBufferQueue` so that records logged while draining are handled inline.
+static const void *const kGULLoggerBufferQueueKey = &kGULLoggerBufferQueueKey;
+
+/// Holds the calling thread's buffer and abandons it when the thread exits.
+static pthread_key_t sGULLoggerBufferKey;
+
+static os_unfair_lock sGULLoggerBuffersLock = OS_UNFAIR_LOCK_INIT;
+
+static GULLoggerThreadBuffer *sGULLoggerBuffers;
+
+static GULLoggerBufferPolicy sGULLoggerBufferPolicy = GULLoggerBufferPolicyDrop;
+
+static NSUInteger sGULLoggerBufferCapacity = kGULLoggerBufferDefaultCapacity;
+
+static uint64_t sGULLoggerDroppedRecordCount;
+
+/// Drops not yet reported by the drain queue.
+static uint64_t sGULLoggerRecentDropCount;
+
+/// The thread currently draining the buffers, if any. A producer on that thread cannot wait for
+/// room, because the drain it would wait for is suspended underneath it.
+static pthread_t sGULLoggerBufferDrainingThread;
+
+void GULLoggerRecordRelease(GULLoggerRecord *record) {
+  CFTypeRef references[] = {record->subsystem, record->category, record->messageCode,
+                            record->message};
+  for (size_t i = 0; i < sizeof(references) / sizeof(references[0]); i++) {
+    if (references[i]) {
+      CFRelease(references[i]);
+    }
+  }
+  record->subsystem = record->category = record->messageCode = record->message = NULL;
+  GULLoggerRecordReleaseArguments(record);
+  GULLoggerRecordReleaseFields(record);
+}
+
+static void GULLoggerBufferScheduleDrain(void) {
+  dispatch_source_merge_data(sGULLoggerBufferDrainSource, 1);
+}
+
+static void GULLoggerThreadBufferAbandon(void *buffer) {
+  __atomic_store_n(&((GULLoggerThreadBuffer *)buffer)->abandoned, YES, __ATOMIC_RELEASE);
+  GULLoggerBufferScheduleDrain();
+}
+
+/// Returns the calling thread's buffer, creating and registering it on first use.
+static GULLoggerThreadBuffer *GULLoggerCurrentThreadBuffer(void) {
+  GULLoggerThreadBuffer *buffer = pthread_getspecific(sGULLoggerBufferKey);
+  if (buffer) {
+    return buffer;
+  }
+
+  NSUInteger capacity = __atomic_load_n(&sGULLoggerBufferCapacity, __ATOMIC_RELAXED);
+  buffer = calloc(1, sizeof(GULLoggerThreadBuffer) + capacity * sizeof(GULLoggerRecord));
+  if (!buffer) {
+    return NULL;
+  }
+  buffer->mask = capacity - 1;
+  if (pthread_setspecific(sGULLoggerBufferKey, buffer) != 0) {
+    free(buffer);
+    return NULL;
+  }
+
+  os_unfair_lock_lock(&sGULLoggerBuffersLock);
+  buffer->next = sGULLoggerBuffers;
+  sGULLoggerBuffers = buffer;
+  os_unfair_lock_unlock(&sGULLoggerBuffersLock);
+  return buffer;
+}
+
+static void GULLoggerBufferDrop(GULLoggerRecord *record) {
+  GULLoggerRecordRelease(record);
+  __atomic_fetch_add(&sGULLoggerDroppedRecordCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&sGULLoggerRecentDropCount, 1, __ATOMIC_RELAXED);
+}
+
+/// Hands the records in `buffer` to the handler in batches. Returns YES if the buffer was abandoned
+/// by its thread and is now empty, so it can be freed.
+static BOOL GULLoggerThreadBufferDrain(GULLoggerThreadBuffer *buffer) {
+  // Read `abandoned` first: the owning thread writes no records after setting it.
+  BOOL abandoned = __atomic_load_n(&buffer->abandoned, __ATOMIC_ACQUIRE);
+  uint64_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+  GULLoggerRecord batch[kGULLoggerBufferDrainBatchSize];
+  // `head` is read again for every batch rather than kept locally, so that records are never
+  // handed out twice even if the handler ends up draining this buffer itself.
+  uint64_t head;
+  while ((head = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED)) < tail) {
+    NSUInteger count = (NSUInteger)MIN(tail - head, (uint64_t)kGULLoggerBufferDrainBatchSize);
+    for (NSUInteger i = 0; i < count; i++) {
+      batch[i] = buffer->records[(head + i) & buffer->mask];
+    }
+    __atomic_store_n(&buffer->head, head + count, __ATOMIC_RELEASE);
+    sGULLoggerBufferHandler(batch, count);
+  }
+  return abandoned;
+}
+
+static BOOL GULLoggerBufferIsDraining(void) {
+  // Only the draining thread stores itself here, so a relaxed load is enough to tell.
+  return pthread_equal(__atomic_load_n(&sGULLoggerBufferDrainingThread, __ATOMIC_RELAXED),
+                       pthread_self());
+}
+
+static void GULLoggerBufferDrain(void) {
+  // A flush from a sink lands here while the drain that called the sink is still in progress. That
+  // drain goes on to hand out the records left, and is the only one that may free buffers it is
+  // still walking.
+  if (GULLoggerBufferIsDraining()) {
+    return;
+  }
+
+  os_unfair_lock_lock(&sGULLoggerBuffersLock);
+  GULLoggerThreadBuffer *buffer = sGULLoggerBuffers;
+  os_unfair_lock_unlock(&sGULLoggerBuffersLock);
+
+  // Buffers are only unlinked and freed here, so the list can be walked without the lock.
+  __atomic_store_n(&sGULLoggerBufferDrainingThread, pthread_self(), __ATOMIC_RELAXED);
+  BOOL foundAbandoned = NO;
+  for (; buffer; buffer = buffer->next) {
+    foundAbandoned |= GULLoggerThreadBufferDrain(buffer);
+  }
+  __atomic_store_n(&sGULLoggerBufferDrainingThread, (pthread_t)NULL, __ATOMIC_RELAXED);
+  if (!foundAbandoned) {
+    return;
+  }
+
+  os_unfair_lock_lock(&sGULLoggerBuffersLock);
+  GULLoggerThreadBuffer **link = &sGULLoggerBuffers;
+  while (*link) {
+    GULLoggerThreadBuffer *candidate = *link;
+    if (__atomic_load_n(&candidate->abandoned, __ATOMIC_ACQUIRE) &&
+        __atomic_load_n(&candidate->head, __ATOMIC_RELAXED) ==
+            __atomic_load_n(&candidate->tail, __ATOMIC_ACQUIRE)) {
+      *link = candidate->next;
+      free(candidate);
+    } else {
+      link = &candidate->next;
+    }
+  }
+  os_unfair_lock_unlock(&sGULLoggerBuffersLock);
+}
+
+void GULLoggerBufferInitialize(dispatch_queue_t drainQueue, GULLoggerRecordHandler handler) {
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sGULLoggerBufferQueue = drainQueue;
+    sGULLoggerBufferHandler = handler;
+    dispatch_queue_set_specific(drainQueue, kGULLoggerBufferQueueKey,
+                                (void *)kGULLoggerBufferQueueKey, NULL);
+    pthread_key_create(&sGULLoggerBufferKey, GULLoggerThreadBufferAbandon);
+
+    sGULLoggerBufferDrainSource =
+        dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_OR, 0, 0, drainQueue);
+    dispatch_source_set_event_handler(sGULLoggerBufferDrainSource, ^{
+      GULLoggerBufferDrain();
+    });
+    dispatch_resume(sGULLoggerBufferDrainSource);
+  });
+}
+
+static BOOL GULLoggerBufferIsOnDrainQueue(void) {
+  return dispatch_get_specific(kGULLoggerBufferQueueKey) == kGULLoggerBufferQueueKey;
+}
+
+void GULLoggerBufferEnqueue(GULLoggerRecord *record) {
+  if (GULLoggerBufferIsOnDrainQueue()) {
+    // Waiting for the drain queue from the drain queue would never finish.
+    sGULLoggerBufferHandler(record, 1);
+    return;
+  }
+
+  GULLoggerThreadBuffer *buffer = GULLoggerCurrentThreadBuffer();
+  if (!buffer) {
+    GULLoggerBufferDrop(record);
+    return;
+  }
+
+  uint64_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_RELAXED);
+  while (tail - __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE) > buffer->mask) {
+    GULLoggerBufferScheduleDrain();
+    // Records logged while draining, e.g. by a sink that hops to its own queue, cannot wait.
+    if (__atomic_load_n(&sGULLoggerBufferPolicy, __ATOMIC_RELAXED) ==
+            GULLoggerBufferPolicyDrop ||
+        GULLoggerBufferIsDraining()) {
+      GULLoggerBufferDrop(record);
+      return;
+    }
+    usleep(kGULLoggerBufferBlockBackoff);
+  }
+
+  buffer->records[tail & buffer->mask] = *record;
+  __atomic_store_n(&buffer->tail, tail + 1, __ATOMIC_RELEASE);
+  GULLoggerBufferScheduleDrain();
+}
+
+void GULLoggerBufferFlush(void) {
+  if (GULLoggerBufferIsOnDrainQueue()) {
+    GULLoggerBufferDrain();
+    return;
+  }
+  dispatch_sync(sGULLoggerBufferQueue, ^{
+    GULLoggerBufferDrain();
+  });
+}
+
+void GULLoggerBufferPerformOnDrainQueue(dispatch_block_t block) {
+  if (GULLoggerBufferIsOnDrainQueue()) {
+    block();
+    return;
+  }
+  dispatch_sync(sGULLoggerBufferQueue, block);
+}
+
+uint64_t GULLoggerBufferTakeRecentDropCount(void) {
+  return __atomic_exchange_n(&sGULLoggerRecentDropCount, 0, __ATOMIC_RELAXED);
+}
+
+#pragma mark - Public
+
+void GULLoggerSetBufferPolicy(GULLoggerBufferPolicy policy) {
+  __atomic_store_n(&sGULLoggerBufferPolicy, policy, __ATOMIC_RELAXED);
+}
+
+void GULLoggerSetBufferCapacity(NSUInteger capacity) {
+  NSUInteger roundedCapacity = 2;
+  while (roundedCapacity < capacity && roundedCapacity <= NSUIntegerMax / 2) {
+    roundedCapacity *= 2;
+  }
+  __atomic_store_n(&sGULLoggerBufferCapacity, roundedCapacity, __ATOMIC_RELAXED);
+}
+
+uint64_t GULLoggerDroppedRecordCount(void) {
+  return __atomic_load_n(&sGULLoggerDroppedRecordCount, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,454 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerFileSink.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <unistd.h>
+
+/// The first bytes of every file, ending in the format version.
+static const uint8_t kGULLoggerFileMagic[8] = {'G', 'U', 'L', 'L', 'O', 'G', '0', '1'};
+
+static NSString *const kGULLoggerFileExtension = @"gullog";
+
+/// The size of a record without its strings and fields. Each record is a little-endian uint32
+/// length of the rest of the record, followed by a uint64 timestamp, a uint8 level, and the
+/// subsystem, category, message code and message, each as a uint32 length followed by UTF-8 bytes.
+/// The fields, if any, follow in key order until the end of the record, each as a string key, a
+/// `GULLoggerFileFieldType` and its value. A length of 0 marks the end of the records, since files
+/// are zero-filled when they are allocated.
+static const NSUInteger kGULLoggerFileRecordFixedSize = 4 + 8 + 1 + 4 * 4;
+
+/// The type of a field value in a file, followed by the value.
+typedef NS_ENUM(uint8_t, GULLoggerFileFieldType) {
+  /// A uint64 holding an int64.
+  GULLoggerFileFieldTypeInt64 = 0,
+  /// A uint64 holding the bits of a double.
+  GULLoggerFileFieldTypeDouble = 1,
+  /// A string.
+  GULLoggerFileFieldTypeString = 2,
+  /// The domain as a string, the code as an int64 and the localized description as a string.
+  GULLoggerFileFieldTypeError = 3,
+  /// No value.
+  GULLoggerFileFieldTypeNull = 4,
+};
+
+/// Reads the values in a record, failing instead of reading past its end.
+typedef struct {
+  const uint8_t *position;
+  const uint8_t *end;
+  BOOL failed;
+} GULLoggerFileReader;
+
+static NSError *GULLoggerFileError(int code) {
+  return [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil];
+}
+
+static void GULLoggerFileStoreUInt32(uint8_t *bytes, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+static void GULLoggerFileStoreUInt64(uint8_t *bytes, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    bytes[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+static uint32_t GULLoggerFileLoadUInt32(const uint8_t *bytes) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= (uint32_t)bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+static uint64_t GULLoggerFileLoadUInt64(const uint8_t *bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= (uint64_t)bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+static void GULLoggerFileAppendUInt8(NSMutableData *data, uint8_t value) {
+  [data appendBytes:&value length:1];
+}
+
+static void GULLoggerFileAppendUInt64(NSMutableData *data, uint64_t value) {
+  uint8_t bytes[8];
+  GULLoggerFileStoreUInt64(bytes, value);
+  [data appendBytes:bytes length:sizeof(bytes)];
+}
+
+static void GULLoggerFileAppendString(NSMutableData *data, NSString *string) {
+  const char *utf8 = string.UTF8String ?: "";
+  size_t length = strlen(utf8);
+  uint8_t lengthBytes[4];
+  GULLoggerFileStoreUInt32(lengthBytes, (uint32_t)length);
+  [data appendBytes:lengthBytes length:sizeof(lengthBytes)];
+  [data appendBytes:utf8 length:length];
+}
+
+/// Encodes the fields of a record, as described for `kGULLoggerFileRecordFixedSize`.
+static NSData *GULLoggerFileEncodeFields(NSDictionary<NSString *, id> *fields) {
+  NSMutableData *data = [NSMutableData data];
+  for (NSString *key in [fields.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+    id value = fields[key];
+    GULLoggerFileAppendString(data, key);
+    if ([value isKindOfClass:[NSNumber class]]) {
+      NSNumber *number = value;
+      if (strcmp(number.objCType, @encode(double)) == 0 ||
+          strcmp(number.objCType, @encode(float)) == 0) {
+        double doubleValue = number.doubleValue;
+        uint64_t bits;
+        memcpy(&bits, &doubleValue, sizeof(bits));
+        GULLoggerFileAppendUInt8(data, GULLoggerFileFieldTypeDouble);
+        GULLoggerFileAppendUInt64(data, bits);
+      } else {
+        GULLoggerFileAppendUInt8(data, GULLoggerFileFieldTypeInt64);
+        GULLoggerFileAppendUInt64(data, (uint64_t)number.longLongValue);
+      }
+    } else if ([value isKindOfClass:[NSError class]]) {
+      NSError *error = value;
+      GULLoggerFileAppendUInt8(data, GULLoggerFileFieldTypeError);
+      GULLoggerFileAppendString(data, error.domain);
+      GULLoggerFileAppendUInt64(data, (uint64_t)(int64_t)error.code);
+      GULLoggerFileAppendString(data, error.localizedDescription);
+    } else if (value == [NSNull null]) {
+      GULLoggerFileAppendUInt8(data, GULLoggerFileFieldTypeNull);
+    } else {
+      GULLoggerFileAppendUInt8(data, GULLoggerFileFieldTypeString);
+      GULLoggerFileAppendString(data, [value description]);
+    }
+  }
+  return data;
+}
+
+/// Returns whether `length` more bytes can be read, marking the reader as failed if not.
+static BOOL GULLoggerFileReaderCanRead(GULLoggerFileReader *reader, NSUInteger length) {
+  if (reader->failed || (NSUInteger)(reader->end - reader->position) < length) {
+    reader->failed = YES;
+    return NO;
+  }
+  return YES;
+}
+
+static uint8_t GULLoggerFileReadUInt8(GULLoggerFileReader *reader) {
+  if (!GULLoggerFileReaderCanRead(reader, 1)) {
+    return 0;
+  }
+  return *reader->position++;
+}
+
+static uint64_t GULLoggerFileReadUInt64(GULLoggerFileReader *reader) {
+  if (!GULLoggerFileReaderCanRead(reader, 8)) {
+    return 0;
+  }
+  uint64_t value = GULLoggerFileLoadUInt64(reader->position);
+  reader->position += 8;
+  return value;
+}
+
+static NSString *GULLoggerFileReadString(GULLoggerFileReader *reader) {
+  if (!GULLoggerFileReaderCanRead(reader, 4)) {
+    return @"";
+  }
+  uint32_t length = GULLoggerFileLoadUInt32(reader->position);
+  reader->position += 4;
+  if (!GULLoggerFileReaderCanRead(reader, length)) {
+    return @"";
+  }
+  NSString *string = [[NSString alloc] initWithBytes:reader->position
+                                              length:length
+                                            encoding:NSUTF8StringEncoding];
+  reader->position += length;
+  return string ?: @"";
+}
+
+/// Decodes the fields that take up the rest of a record.
+static NSDictionary<NSString *, id> *GULLoggerFileReadFields(GULLoggerFileReader *reader) {
+  NSMutableDictionary<NSString *, id> *fields = [NSMutableDictionary dictionary];
+  while (!reader->failed && reader->position < reader->end) {
+    NSString *key = GULLoggerFileReadString(reader);
+    id value;
+    switch (GULLoggerFileReadUInt8(reader)) {
+      case GULLoggerFileFieldTypeInt64:
+        value = @((int64_t)GULLoggerFileReadUInt64(reader));
+        break;
+      case GULLoggerFileFieldTypeDouble: {
+        uint64_t bits = GULLoggerFileReadUInt64(reader);
+        double doubleValue;
+        memcpy(&doubleValue, &bits, sizeof(doubleValue));
+        value = @(doubleValue);
+        break;
+      }
+      case GULLoggerFileFieldTypeString:
+        value = GULLoggerFileReadString(reader);
+        break;
+      case GULLoggerFileFieldTypeError: {
+        NSString *domain = GULLoggerFileReadString(reader);
+        NSInteger code = (NSInteger)(int64_t)GULLoggerFileReadUInt64(reader);
+        NSString *description = GULLoggerFileReadString(reader);
+        value = [NSError errorWithDomain:domain
+                                    code:code
+                                userInfo:@{NSLocalizedDescriptionKey : description}];
+        break;
+      }
+      case GULLoggerFileFieldTypeNull:
+        value = [NSNull null];
+        break;
+      default:
+        reader->failed = YES;
+        break;
+    }
+    if (value) {
+      fields[key] = value;
+    }
+  }
+  return fields;
+}
+
+/// Allocates `size` zero-filled bytes of disk for `fd`, so that writing to its mapping cannot fail
+/// with SIGBUS when the disk fills up. Returns 0 or an errno value.
+static int GULLoggerFileAllocate(int fd, off_t size) {
+#ifdef F_PREALLOCATE
+  fstore_t store = {
+      .fst_flags = F_ALLOCATEALL,
+      .fst_posmode = F_PEOFPOSMODE,
+      .fst_offset = 0,
+      .fst_length = size,
+  };
+  if (fcntl(fd, F_PREALLOCATE, &store) == -1 || ftruncate(fd, size) == -1) {
+    return errno;
+  }
+  return 0;
+#else
+  return posix_fallocate(fd, 0, size);
+#endif
+}
+
+@implementation GULLoggerFileSink {
+  /// The file being written, or -1 if none is open.
+  int _fileDescriptor;
+  uint8_t *_mappedFile;
+  /// Where the next record goes in `_mappedFile`.
+  NSUInteger _offset;
+  uint64_t _nextFileNumber;
+}
+
++ (NSArray<GULLoggerSinkRecord *> *)recordsInFileAtPath:(NSString *)path error:(NSError **)error {
+  NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:error];
+  if (!data) {
+    return nil;
+  }
+  const uint8_t *bytes = data.bytes;
+  NSUInteger length = data.length;
+  if (length < sizeof(kGULLoggerFileMagic) ||
+      memcmp(bytes, kGULLoggerFileMagic, sizeof(kGULLoggerFileMagic)) != 0) {
+    if (error) {
+      *error = GULLoggerFileError(EINVAL);
+    }
+    return nil;
+  }
+
+  NSMutableArray<GULLoggerSinkRecord *> *records = [NSMutableArray array];
+  NSUInteger offset = sizeof(kGULLoggerFileMagic);
+  while (length - offset >= kGULLoggerFileRecordFixedSize) {
+    NSUInteger recordLength = GULLoggerFileLoadUInt32(bytes + offset) + 4;
+    if (recordLength < kGULLoggerFileRecordFixedSize || recordLength > length - offset) {
+      // The end of the records, or a record cut short by a crash.
+      break;
+    }
+    GULLoggerFileReader reader = {
+        .position = bytes + offset + 4,
+        .end = bytes + offset + recordLength,
+    };
+    uint64_t timestamp = GULLoggerFileReadUInt64(&reader);
+    GULLoggerLevel level = (GULLoggerLevel)GULLoggerFileReadUInt8(&reader);
+    NSString *subsystem = GULLoggerFileReadString(&reader);
+    NSString *category = GULLoggerFileReadString(&reader);
+    NSString *messageCode = GULLoggerFileReadString(&reader);
+    NSString *message = GULLoggerFileReadString(&reader);
+    NSDictionary<NSString *, id> *fields = GULLoggerFileReadFields(&reader);
+    if (reader.failed) {
+      if (error) {
+        *error = GULLoggerFileError(EINVAL);
+      }
+      return nil;
+    }
+    [records addObject:[[GULLoggerSinkRecord alloc] initWithLevel:level
+                                                        timestamp:timestamp
+                                                        subsystem:subsystem
+                                                         category:category
+                                                      messageCode:messageCode
+                                                          message:message
+                                                           fields:fields]];
+    offset += recordLength;
+  }
+  return records;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                  maximumFileSize:(NSUInteger)maximumFileSize
+                 maximumFileCount:(NSUInteger)maximumFileCount
+                            error:(NSError **)error {
+  self = [super init];
+  if (self) {
+    NSUInteger pageSize = (NSUInteger)getpagesize();
+    _directory = [directory copy];
+    _maximumFileSize = (MAX(maximumFileSize, 1) + pageSize - 1) / pageSize * pageSize;
+    _maximumFileCount = MAX(maximumFileCount, 1);
+    _fileDescriptor = -1;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                   withIntermediateDirectories:YES
+                                                    attributes:nil
+                                                         error:error]) {
+      return nil;
+    }
+    _nextFileNumber = (uint64_t)self.filePaths.lastObject.lastPathComponent.longLongValue + 1;
+    if (![self openNextFileWithError:error]) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self closeFile];
+}
+
+- (NSArray<NSString *> *)filePaths {
+  NSArray<NSString *> *names =
+      [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directory error:NULL];
+  NSMutableArray<NSString *> *paths = [NSMutableArray array];
+  // File names are zero-padded numbers, so they sort in the order the files were created.
+  for (NSString *name in [names sortedArrayUsingSelector:@selector(compare:)]) {
+    if ([name.pathExtension isEqualToString:kGULLoggerFileExtension]) {
+      [paths addObject:[self.directory stringByAppendingPathComponent:name]];
+    }
+  }
+  return paths;
+}
+
+/// Creates, allocates and maps the next file, then deletes the oldest files over the limit.
+- (BOOL)openNextFileWithError:(NSError **)error {
+  NSString *name = [NSString
+      stringWithFormat:@"%020llu.%@", (unsigned long long)_nextFileNumber, kGULLoggerFileExtension];
+  _nextFileNumber++;
+  NSString *path = [self.directory stringByAppendingPathComponent:name];
+
+  int fd = open(path.fileSystemRepresentation, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd == -1) {
+    if (error) {
+      *error = GULLoggerFileError(errno);
+    }
+    return NO;
+  }
+  int allocateError = GULLoggerFileAllocate(fd, (off_t)self.maximumFileSize);
+  void *mappedFile = allocateError ? MAP_FAILED
+                                   : mmap(NULL, self.maximumFileSize, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED, fd, 0);
+  if (mappedFile == MAP_FAILED) {
+    if (error) {
+      *error = GULLoggerFileError(allocateError ?: errno);
+    }
+    close(fd);
+    unlink(path.fileSystemRepresentation);
+    return NO;
+  }
+
+  _fileDescriptor = fd;
+  _mappedFile = mappedFile;
+  memcpy(_mappedFile, kGULLoggerFileMagic, sizeof(kGULLoggerFileMagic));
+  _offset = sizeof(kGULLoggerFileMagic);
+
+  NSArray<NSString *> *paths = self.filePaths;
+  for (NSUInteger i = 0; i + self.maximumFileCount < paths.count; i++) {
+    unlink(paths[i].fileSystemRepresentation);
+  }
+  return YES;
+}
+
+/// Unmaps the current file and trims it to the records written to it.
+- (void)closeFile {
+  if (_fileDescriptor == -1) {
+    return;
+  }
+  munmap(_mappedFile, self.maximumFileSize);
+  ftruncate(_fileDescriptor, (off_t)_offset);
+  close(_fileDescriptor);
+  _fileDescriptor = -1;
+  _mappedFile = NULL;
+}
+
+#pragma mark - GULLoggerSink
+
+- (void)writeRecords:(NSArray<GULLoggerSinkRecord *> *)records {
+  for (GULLoggerSinkRecord *record in records) {
+    // `UTF8String` returns NULL for strings that cannot be converted, which are written as empty.
+    const char *strings[4] = {record.subsystem.UTF8String ?: "", record.category.UTF8String ?: "",
+                              record.messageCode.UTF8String ?: "", record.message.UTF8String ?: ""};
+    size_t stringLengths[4];
+    NSData *fields = record.fields.count > 0 ? GULLoggerFileEncodeFields(record.fields) : nil;
+    NSUInteger recordLength = kGULLoggerFileRecordFixedSize + fields.length;
+    for (int i = 0; i < 4; i++) {
+      stringLengths[i] = strlen(strings[i]);
+      recordLength += stringLengths[i];
+    }
+    if (recordLength > self.maximumFileSize - sizeof(kGULLoggerFileMagic)) {
+      _skippedRecordCount++;
+      continue;
+    }
+    if (_fileDescriptor == -1 || recordLength > self.maximumFileSize - _offset) {
+      [self closeFile];
+      if (![self openNextFileWithError:NULL]) {
+        _skippedRecordCount++;
+        continue;
+      }
+    }
+
+    uint8_t *bytes = _mappedFile + _offset;
+    uint8_t *field = bytes + 4;
+    GULLoggerFileStoreUInt64(field, record.timestamp);
+    field[8] = (uint8_t)record.level;
+    field += 9;
+    for (int i = 0; i < 4; i++) {
+      GULLoggerFileStoreUInt32(field, (uint32_t)stringLengths[i]);
+      memcpy(field + 4, strings[i], stringLengths[i]);
+      field += 4 + stringLengths[i];
+    }
+    if (fields) {
+      memcpy(field, fields.bytes, fields.length);
+    }
+    // The length goes in last, after a release fence so that neither the compiler nor the CPU
+    // moves it ahead of the rest of the record. A reader of the mapped file, or of the file left by
+    // a crash, then never takes a partially written record for a complete one.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    GULLoggerFileStoreUInt32(bytes, (uint32_t)(recordLength - 4));
+    _offset += recordLength;
+  }
+}
+
+- (void)flush {
+  if (_fileDescriptor != -1) {
+    msync(_mappedFile, _offset, MS_ASYNC);
+  }
+}
+
+@end
@@ -0,0 +1,247 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerHandleInternal.h"
+
+#import <os/lock.h>
+#import <pthread.h>
+
+/// An immutable copy of the level overrides, which `GULLoggerLevelOverride` reads without the lock.
+@interface GULLoggerLevelOverrides : NSObject {
+ @public
+  /// The value of `sGULLoggerLevelOverridesGeneration` the copy was taken at.
+  NSUInteger _generation;
+  /// The level overrides by subsystem and then category.
+  NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *_levels;
+}
+@end
+
+@implementation GULLoggerLevelOverrides
+@end
+
+/// Guards the variables below and the level fields of the handles.
+static os_unfair_lock sGULLoggerHandlesLock = OS_UNFAIR_LOCK_INIT;
+
+/// The registered handles, by subsystem and then category.
+static NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSValue *> *>
+    *sGULLoggerHandles;
+
+/// The number of handles registered by `GULLoggerImplicitHandle`.
+static NSUInteger sGULLoggerImplicitHandleCount;
+
+static GULLoggerLevel sGULLoggerHandlesGlobalLevel = GULLoggerLevelNotice;
+
+/// The number of handles with a level override. Read without the lock by `GULLoggerLevelOverride`,
+/// which returns at once while no category has its own level.
+static NSUInteger sGULLoggerLevelOverrideCount;
+
+/// The current copy of the level overrides.
+static GULLoggerLevelOverrides *sGULLoggerLevelOverrides;
+
+/// Incremented whenever a level override changes; read without the lock, so that threads notice
+/// that their cached copy is out of date.
+static NSUInteger sGULLoggerLevelOverridesGeneration;
+
+/// Holds the copy of the level overrides last used by the calling thread, retained, and releases it
+/// when the thread exits. Each thread keeps its own reference so that a copy is never released
+/// while in use.
+static pthread_key_t sGULLoggerLevelOverridesKey;
+
+static BOOL sGULLoggerHandlesDebugMode;
+
+/// Recomputes the level read by `GULLoggerHandleIsLoggable`. Must be called with the lock held.
+static void GULLoggerHandleUpdateLoggableLevel(GULLoggerHandle *handle) {
+  int loggableLevel;
+  if (sGULLoggerHandlesDebugMode) {
+    loggableLevel = GULLoggerLevelMax;
+  } else if (handle->levelOverride) {
+    loggableLevel = handle->levelOverride;
+  } else {
+    loggableLevel = (int)sGULLoggerHandlesGlobalLevel;
+  }
+  __atomic_store_n(&handle->header.loggableLevel, loggableLevel, __ATOMIC_RELAXED);
+}
+
+/// Returns the registered handle for a subsystem and category, or NULL if there is none. Must be
+/// called with the lock held.
+static GULLoggerHandle *_Nullable GULLoggerFindHandle(NSString *subsystem, NSString *category) {
+  return sGULLoggerHandles[subsystem][category].pointerValue;
+}
+
+/// Registers a new handle for a subsystem and category. Must be called with the lock held, and
+/// only if there is no handle for them yet.
+static GULLoggerHandle *GULLoggerAddHandle(NSString *subsystem, NSString *category) {
+  if (!sGULLoggerHandles) {
+    sGULLoggerHandles = [NSMutableDictionary dictionary];
+  }
+  NSMutableDictionary<NSString *, NSValue *> *subsystemHandles = sGULLoggerHandles[subsystem];
+  if (!subsystemHandles) {
+    subsystemHandles = [NSMutableDictionary dictionary];
+    sGULLoggerHandles[[subsystem copy]] = subsystemHandles;
+  }
+
+  GULLoggerHandle *handle = calloc(1, sizeof(GULLoggerHandle));
+  if (!handle) {
+    os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+    @throw [NSException exceptionWithName:NSMallocException
+                                   reason:@"Failed to allocate a GULLoggerHandle."
+                                 userInfo:nil];
+  }
+  handle->subsystem = CFBridgingRetain([subsystem copy]);
+  handle->category = CFBridgingRetain([category copy]);
+  handle->log = CFBridgingRetain(os_log_create(subsystem.UTF8String, category.UTF8String));
+  GULLoggerHandleUpdateLoggableLevel(handle);
+  subsystemHandles[(__bridge NSString *)handle->category] = [NSValue valueWithPointer:handle];
+  return handle;
+}
+
+GULLoggerHandle *GULLoggerRegisterHandle(NSString *subsystem, NSString *category) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  GULLoggerHandle *handle = GULLoggerFindHandle(subsystem, category);
+  if (!handle) {
+    handle = GULLoggerAddHandle(subsystem, category);
+  }
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+  return handle;
+}
+
+GULLoggerHandle *GULLoggerImplicitHandle(NSString *subsystem, NSString *category) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  GULLoggerHandle *handle = GULLoggerFindHandle(subsystem, category);
+  if (!handle && sGULLoggerImplicitHandleCount < kGULLoggerMaximumImplicitHandles) {
+    handle = GULLoggerAddHandle(subsystem, category);
+    sGULLoggerImplicitHandleCount++;
+  }
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+  return handle;
+}
+
+GULLoggerHandle *GULLoggerExistingHandle(NSString *subsystem, NSString *category) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  GULLoggerHandle *handle = GULLoggerFindHandle(subsystem, category);
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+  return handle;
+}
+
+void GULLoggerHandlesSetGlobalLevel(GULLoggerLevel globalLevel, BOOL debugMode) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  sGULLoggerHandlesGlobalLevel = globalLevel;
+  sGULLoggerHandlesDebugMode = debugMode;
+  NSEnumerator<NSMutableDictionary<NSString *, NSValue *> *> *subsystems =
+      sGULLoggerHandles.objectEnumerator;
+  for (NSMutableDictionary<NSString *, NSValue *> *subsystemHandles in subsystems) {
+    for (NSValue *handle in subsystemHandles.objectEnumerator) {
+      GULLoggerHandleUpdateLoggableLevel(handle.pointerValue);
+    }
+  }
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+}
+
+/// Publishes a new copy of the level overrides. Must be called with the lock held.
+static void GULLoggerPublishLevelOverrides(void) {
+  NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *levels =
+      [NSMutableDictionary dictionary];
+  for (NSString *subsystem in sGULLoggerHandles) {
+    NSMutableDictionary<NSString *, NSNumber *> *categoryLevels = [NSMutableDictionary dictionary];
+    for (NSValue *value in sGULLoggerHandles[subsystem].objectEnumerator) {
+      GULLoggerHandle *handle = value.pointerValue;
+      if (handle->levelOverride) {
+        categoryLevels[(__bridge NSString *)handle->category] = @(handle->levelOverride);
+      }
+    }
+    if (categoryLevels.count > 0) {
+      levels[subsystem] = [categoryLevels copy];
+    }
+  }
+
+  GULLoggerLevelOverrides *overrides = [[GULLoggerLevelOverrides alloc] init];
+  overrides->_generation = sGULLoggerLevelOverridesGeneration + 1;
+  overrides->_levels = [levels copy];
+  sGULLoggerLevelOverrides = overrides;
+  __atomic_store_n(&sGULLoggerLevelOverridesGeneration, overrides->_generation, __ATOMIC_RELEASE);
+}
+
+void GULLoggerHandleSetLevelOverride(GULLoggerHandle *handle, int levelOverride) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  if (handle->levelOverride != levelOverride) {
+    if (!handle->levelOverride || !levelOverride) {
+      NSUInteger count =
+          levelOverride ? sGULLoggerLevelOverrideCount + 1 : sGULLoggerLevelOverrideCount - 1;
+      __atomic_store_n(&sGULLoggerLevelOverrideCount, count, __ATOMIC_RELAXED);
+    }
+    handle->levelOverride = levelOverride;
+    GULLoggerHandleUpdateLoggableLevel(handle);
+    GULLoggerPublishLevelOverrides();
+  }
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+}
+
+void GULLoggerHandlesClearLevelOverrides(void) {
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  NSEnumerator<NSMutableDictionary<NSString *, NSValue *> *> *subsystems =
+      sGULLoggerHandles.objectEnumerator;
+  for (NSMutableDictionary<NSString *, NSValue *> *subsystemHandles in subsystems) {
+    for (NSValue *value in subsystemHandles.objectEnumerator) {
+      GULLoggerHandle *handle = value.pointerValue;
+      if (handle->levelOverride) {
+        handle->levelOverride = 0;
+        GULLoggerHandleUpdateLoggableLevel(handle);
+      }
+    }
+  }
+  __atomic_store_n(&sGULLoggerLevelOverrideCount, 0, __ATOMIC_RELAXED);
+  GULLoggerPublishLevelOverrides();
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+}
+
+static void GULLoggerLevelOverridesRelease(void *overrides) {
+  CFRelease(overrides);
+}
+
+/// Returns the calling thread's copy of the level overrides, refreshing it under the lock only if
+/// they changed since it was taken.
+static GULLoggerLevelOverrides *_Nullable GULLoggerCurrentLevelOverrides(void) {
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    pthread_key_create(&sGULLoggerLevelOverridesKey, GULLoggerLevelOverridesRelease);
+  });
+
+  NSUInteger generation = __atomic_load_n(&sGULLoggerLevelOverridesGeneration, __ATOMIC_ACQUIRE);
+  CFTypeRef cached = pthread_getspecific(sGULLoggerLevelOverridesKey);
+  GULLoggerLevelOverrides *overrides = (__bridge GULLoggerLevelOverrides *)cached;
+  if (overrides && overrides->_generation == generation) {
+    return overrides;
+  }
+
+  os_unfair_lock_lock(&sGULLoggerHandlesLock);
+  overrides = sGULLoggerLevelOverrides;
+  os_unfair_lock_unlock(&sGULLoggerHandlesLock);
+  if (!overrides) {
+    return nil;
+  }
+  if (pthread_setspecific(sGULLoggerLevelOverridesKey, CFBridgingRetain(overrides)) != 0) {
+    CFRelease((__bridge CFTypeRef)overrides);
+  } else if (cached) {
+    CFRelease(cached);
+  }
+  return overrides;
+}
+
+int GULLoggerLevelOverride(NSString *subsystem, NSString *category) {
+  if (__atomic_load_n(&sGULLoggerLevelOverrideCount, __ATOMIC_RELAXED) == 0) {
+    return 0;
+  }
+  GULLoggerLevelOverrides *overrides = GULLoggerCurrentLevelOverrides();
+  return overrides ? [overrides->_levels[subsystem][category] intValue] : 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <os/log.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A registered subsystem and category. Handles are created by `GULLoggerRegisterHandle` and never
+/// freed, so they can be referenced from log records without being retained.
+struct GULLoggerHandle {
+  /// Must be the first member; read inline by `GULLoggerHandleIsLoggable`. Written under the
+  /// registry lock whenever the global level, debug mode or `levelOverride` changes.
+  GULLoggerHandleHeader header;
+  CFTypeRef subsystem;  // NSString
+  CFTypeRef category;   // NSString
+  CFTypeRef log;        // os_log_t
+  /// The maximum level logged for this category, or 0 to use the global level. Guarded by the
+  /// registry lock.
+  int levelOverride;
+};
+
+/// The most handles `GULLoggerImplicitHandle` registers. Beyond that, messages logged by subsystem
+/// and category strings are written without a handle, so that dynamically built category names
+/// cannot grow the registry of immortal handles without bound.
+enum { kGULLoggerMaximumImplicitHandles = 64 };
+
+/// Returns the handle for a subsystem and category that messages were logged for by name,
+/// registering one if fewer than `kGULLoggerMaximumImplicitHandles` were registered this way, or
+/// NULL.
+GULLoggerHandle *_Nullable GULLoggerImplicitHandle(NSString *subsystem, NSString *category);
+
+/// Returns the handle for a subsystem and category if one is registered, or NULL.
+GULLoggerHandle *_Nullable GULLoggerExistingHandle(NSString *subsystem, NSString *category);
+
+/// Records the global level and debug mode, and updates the loggable level of every handle.
+void GULLoggerHandlesSetGlobalLevel(GULLoggerLevel globalLevel, BOOL debugMode);
+
+/// Sets the level override of `handle`, or clears it if `levelOverride` is 0, and updates its
+/// loggable level.
+void GULLoggerHandleSetLevelOverride(GULLoggerHandle *handle, int levelOverride);
+
+/// Clears the level overrides of all handles.
+void GULLoggerHandlesClearLevelOverrides(void);
+
+/// Returns the level override for a subsystem and category, or 0 if there is none. Reads a
+/// per-thread copy of the overrides without a lock, and only takes the lock to refresh that copy
+/// after an override changed.
+int GULLoggerLevelOverride(NSString *subsystem, NSString *category);
+
+NS_ASSUME_NONNULL_END
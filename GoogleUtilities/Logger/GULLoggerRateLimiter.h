@@ -0,0 +1,32 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The message code of the periodic summaries of suppressed messages. Never rate limited.
+extern NSString *const kGULLoggerRateLimitSummaryMessageCode;
+
+/// Sets the queue on which suppressed messages are summarized. Subsequent calls have no effect.
+void GULLoggerRateLimiterInitialize(dispatch_queue_t reportQueue);
+
+/// Returns whether a message with `messageCode` may be logged now, taking a token from the bucket
+/// of the code if a rate limit applies to it. Returns YES right away if no rate limits are set, and
+/// without taking a lock or allocating if none applies to `messageCode`.
+BOOL GULLoggerRateLimiterShouldLog(NSString *messageCode);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,249 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerRateLimiter.h"
+
+#import <os/lock.h>
+#import <pthread.h>
+#import <time.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+
+NSString *const kGULLoggerRateLimitSummaryMessageCode = @"I-COR000025";
+
+/// How long suppressed messages are counted before they are summarized.
+static const int64_t kGULLoggerRateLimitSummaryInterval = 10 * NSEC_PER_SEC;
+
+/// A rate limit set for a message code prefix.
+@interface GULLoggerRateLimit : NSObject {
+ @public
+  double _messagesPerSecond;
+  NSUInteger _burst;
+}
+@end
+
+@implementation GULLoggerRateLimit
+@end
+
+/// An immutable copy of the rate limits, which logging threads match message codes against without
+/// taking the lock.
+@interface GULLoggerRateLimitSnapshot : NSObject {
+ @public
+  /// The value of `sGULLoggerRateLimitsGeneration` the snapshot was taken at.
+  NSUInteger _generation;
+  /// The rate limits by message code prefix.
+  NSDictionary<NSString *, GULLoggerRateLimit *> *_limits;
+}
+@end
+
+@implementation GULLoggerRateLimitSnapshot
+@end
+
+/// The token bucket of a single rate limited message code.
+@interface GULLoggerRateBucket : NSObject {
+ @public
+  /// The limit the tokens were counted for. The bucket starts over when a different one applies.
+  GULLoggerRateLimit *_limit;
+  double _tokens;
+  uint64_t _refilledAt;
+  NSUInteger _suppressedCount;
+}
+@end
+
+@implementation GULLoggerRateBucket
+@end
+
+/// Guards the variables below and the buckets.
+static os_unfair_lock sGULLoggerRateLimiterLock = OS_UNFAIR_LOCK_INIT;
+
+/// The rate limits by message code prefix.
+static NSMutableDictionary<NSString *, GULLoggerRateLimit *> *sGULLoggerRateLimits;
+
+/// The current snapshot of `sGULLoggerRateLimits`.
+static GULLoggerRateLimitSnapshot *sGULLoggerRateLimitSnapshot;
+
+/// Incremented whenever the rate limits change; read without the lock, so that threads notice that
+/// their cached snapshot is out of date.
+static NSUInteger sGULLoggerRateLimitsGeneration;
+
+/// Holds the snapshot last used by the calling thread, retained, and releases it when the thread
+/// exits. Each thread keeps its own reference so that a snapshot is never released while in use.
+static pthread_key_t sGULLoggerRateLimitSnapshotKey;
+
+/// The buckets of rate limited message codes, by message code.
+static NSMutableDictionary<NSString *, GULLoggerRateBucket *> *sGULLoggerRateBuckets;
+
+/// Whether a summary of suppressed messages is scheduled.
+static BOOL sGULLoggerRateLimitSummaryScheduled;
+
+static dispatch_queue_t sGULLoggerRateLimiterReportQueue;
+
+/// Whether any rate limits are set; read without the lock.
+static BOOL sGULLoggerRateLimitsEnabled;
+
+static void GULLoggerRateLimitSnapshotRelease(void *snapshot) {
+  CFRelease(snapshot);
+}
+
+void GULLoggerRateLimiterInitialize(dispatch_queue_t reportQueue) {
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sGULLoggerRateLimiterReportQueue = reportQueue;
+    pthread_key_create(&sGULLoggerRateLimitSnapshotKey, GULLoggerRateLimitSnapshotRelease);
+  });
+}
+
+/// Returns the calling thread's snapshot of the rate limits, refreshing it under the lock only if
+/// the limits changed since it was taken.
+static GULLoggerRateLimitSnapshot *GULLoggerCurrentRateLimitSnapshot(void) {
+  NSUInteger generation = __atomic_load_n(&sGULLoggerRateLimitsGeneration, __ATOMIC_ACQUIRE);
+  CFTypeRef cached = pthread_getspecific(sGULLoggerRateLimitSnapshotKey);
+  GULLoggerRateLimitSnapshot *snapshot = (__bridge GULLoggerRateLimitSnapshot *)cached;
+  if (snapshot && snapshot->_generation == generation) {
+    return snapshot;
+  }
+
+  os_unfair_lock_lock(&sGULLoggerRateLimiterLock);
+  snapshot = sGULLoggerRateLimitSnapshot;
+  os_unfair_lock_unlock(&sGULLoggerRateLimiterLock);
+  if (pthread_setspecific(sGULLoggerRateLimitSnapshotKey, CFBridgingRetain(snapshot)) != 0) {
+    CFRelease((__bridge CFTypeRef)snapshot);
+  } else if (cached) {
+    CFRelease(cached);
+  }
+  return snapshot;
+}
+
+/// Returns the limit for the longest prefix of `messageCode` in `snapshot`, if any.
+static GULLoggerRateLimit *GULLoggerRateLimitForMessageCode(GULLoggerRateLimitSnapshot *snapshot,
+                                                           NSString *messageCode) {
+  NSString *longestPrefix;
+  for (NSString *prefix in snapshot->_limits) {
+    if ([messageCode hasPrefix:prefix] && prefix.length > longestPrefix.length) {
+      longestPrefix = prefix;
+    }
+  }
+  return longestPrefix ? snapshot->_limits[longestPrefix] : nil;
+}
+
+/// Logs how many messages were suppressed per code since the last summary. Runs on the report
+/// queue.
+static void GULLoggerRateLimiterSummarize(void) {
+  NSMutableDictionary<NSString *, NSNumber *> *suppressedCounts = [NSMutableDictionary dictionary];
+  os_unfair_lock_lock(&sGULLoggerRateLimiterLock);
+  for (NSString *messageCode in sGULLoggerRateBuckets) {
+    GULLoggerRateBucket *bucket = sGULLoggerRateBuckets[messageCode];
+    if (bucket->_suppressedCount > 0) {
+      suppressedCounts[messageCode] = @(bucket->_suppressedCount);
+      bucket->_suppressedCount = 0;
+    }
+  }
+  sGULLoggerRateLimitSummaryScheduled = NO;
+  os_unfair_lock_unlock(&sGULLoggerRateLimiterLock);
+
+  NSArray<NSString *> *messageCodes =
+      [suppressedCounts.allKeys sortedArrayUsingSelector:@selector(compare:)];
+  for (NSString *messageCode in messageCodes) {
+    GULOSLogWarning(kGULLogSubsystem, @"[GULLogger]", YES, kGULLoggerRateLimitSummaryMessageCode,
+                    @"%@ messages with code %@ were suppressed by its rate limit.",
+                    suppressedCounts[messageCode], messageCode);
+  }
+}
+
+BOOL GULLoggerRateLimiterShouldLog(NSString *messageCode) {
+  if (!__atomic_load_n(&sGULLoggerRateLimitsEnabled, __ATOMIC_RELAXED) ||
+      [messageCode isEqualToString:kGULLoggerRateLimitSummaryMessageCode]) {
+    return YES;
+  }
+
+  // Codes without a limit are matched against the thread's snapshot and never take the lock.
+  GULLoggerRateLimit *limit =
+      GULLoggerRateLimitForMessageCode(GULLoggerCurrentRateLimitSnapshot(), messageCode);
+  if (!limit) {
+    return YES;
+  }
+
+  uint64_t now = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+  BOOL shouldLog = YES;
+  BOOL scheduleSummary = NO;
+  os_unfair_lock_lock(&sGULLoggerRateLimiterLock);
+  GULLoggerRateBucket *bucket = sGULLoggerRateBuckets[messageCode];
+  if (!bucket) {
+    bucket = [[GULLoggerRateBucket alloc] init];
+    sGULLoggerRateBuckets[[messageCode copy]] = bucket;
+  }
+  if (bucket->_limit != limit) {
+    bucket->_limit = limit;
+    bucket->_tokens = limit->_burst;
+    bucket->_refilledAt = now;
+  }
+
+  double refill = (double)(now - bucket->_refilledAt) / NSEC_PER_SEC * limit->_messagesPerSecond;
+  bucket->_tokens = MIN((double)limit->_burst, bucket->_tokens + refill);
+  bucket->_refilledAt = now;
+  if (bucket->_tokens >= 1) {
+    bucket->_tokens -= 1;
+  } else {
+    shouldLog = NO;
+    bucket->_suppressedCount++;
+    scheduleSummary = !sGULLoggerRateLimitSummaryScheduled;
+    sGULLoggerRateLimitSummaryScheduled = YES;
+  }
+  os_unfair_lock_unlock(&sGULLoggerRateLimiterLock);
+
+  if (scheduleSummary) {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, kGULLoggerRateLimitSummaryInterval),
+                   sGULLoggerRateLimiterReportQueue, ^{
+                     GULLoggerRateLimiterSummarize();
+                   });
+  }
+  return shouldLog;
+}
+
+/// Publishes a new snapshot of `sGULLoggerRateLimits`. Must be called with the lock held.
+static void GULLoggerPublishRateLimits(void) {
+  GULLoggerRateLimitSnapshot *snapshot = [[GULLoggerRateLimitSnapshot alloc] init];
+  snapshot->_generation = sGULLoggerRateLimitsGeneration + 1;
+  snapshot->_limits = [sGULLoggerRateLimits copy];
+  sGULLoggerRateLimitSnapshot = snapshot;
+  __atomic_store_n(&sGULLoggerRateLimitsGeneration, snapshot->_generation, __ATOMIC_RELEASE);
+  __atomic_store_n(&sGULLoggerRateLimitsEnabled, sGULLoggerRateLimits.count > 0, __ATOMIC_RELAXED);
+}
+
+#pragma mark - Public
+
+void GULLoggerSetRateLimit(NSString *messageCodePrefix,
+                           double messagesPerSecond,
+                           NSUInteger burst) {
+  GULLoggerInitialize();
+  GULLoggerRateLimit *limit = [[GULLoggerRateLimit alloc] init];
+  limit->_messagesPerSecond = MAX(messagesPerSecond, 0);
+  limit->_burst = burst;
+
+  os_unfair_lock_lock(&sGULLoggerRateLimiterLock);
+  if (!sGULLoggerRateLimits) {
+    sGULLoggerRateLimits = [NSMutableDictionary dictionary];
+    sGULLoggerRateBuckets = [NSMutableDictionary dictionary];
+  }
+  sGULLoggerRateLimits[[messageCodePrefix copy]] = limit;
+  GULLoggerPublishRateLimits();
+  os_unfair_lock_unlock(&sGULLoggerRateLimiterLock);
+}
+
+void GULLoggerRemoveRateLimit(NSString *messageCodePrefix) {
+  os_unfair_lock_lock(&sGULLoggerRateLimiterLock);
+  [sGULLoggerRateLimits removeObjectForKey:messageCodePrefix];
+  GULLoggerPublishRateLimits();
+  os_unfair_lock_unlock(&sGULLoggerRateLimiterLock);
+}
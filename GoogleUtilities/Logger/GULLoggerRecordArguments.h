@@ -0,0 +1,38 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GoogleUtilities/Logger/GULLoggerBuffer.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Copies the arguments in `args` described by `format` into a compact binary form allocated for
+/// `record` and retains `format`, so that the message can be formatted later. `args` itself is left
+/// unconsumed. `%s` arguments with a precision are read no further than the precision.
+///
+/// Returns NO, leaving `record` unchanged, if the format uses a conversion that cannot be captured
+/// (`*` widths, positional arguments, `%n`, wide or `long double` arguments) or the arguments do
+/// not fit; the caller must then format the message itself.
+BOOL GULLoggerRecordCaptureArguments(GULLoggerRecord *record, NSString *format, va_list args);
+
+/// Returns the message of `record`, formatting its captured arguments if needed.
+NSString *GULLoggerRecordMessage(const GULLoggerRecord *record);
+
+/// Releases the format and any objects among the captured arguments of `record`.
+void GULLoggerRecordReleaseArguments(GULLoggerRecord *record);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,400 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerRecordArguments.h"
+
+#import <stddef.h>
+#import <stdint.h>
+#import <string.h>
+
+/// The most bytes of captured arguments a record holds. Messages with more are formatted eagerly.
+enum { kGULLoggerCapturedArgumentsCapacity = 48 };
+
+/// Allocated only for records whose message is formatted on the drain queue, so that records of
+/// eagerly formatted messages stay small.
+struct GULLoggerCapturedArguments {
+  CFTypeRef format;  // NSString
+  uint8_t length;
+  uint8_t bytes[];
+};
+
+/// The tag in front of each captured argument, which determines the size of the value after it.
+typedef NS_ENUM(uint8_t, GULLoggerArgumentType) {
+  /// A conversion that cannot be captured; never stored.
+  GULLoggerArgumentTypeUnsupported = 0,
+  /// An `int32_t`, for integer conversions of up to 32 bits.
+  GULLoggerArgumentTypeInt32,
+  /// An `int64_t`, for integer conversions of 64 bits.
+  GULLoggerArgumentTypeInt64,
+  /// A `double`.
+  GULLoggerArgumentTypeDouble,
+  /// A `void *` for `%p`.
+  GULLoggerArgumentTypePointer,
+  /// A retained object pointer for `%@`, which may be NULL.
+  GULLoggerArgumentTypeObject,
+  /// A length byte followed by the bytes of a C string and its terminating NUL.
+  GULLoggerArgumentTypeCString,
+  /// A NULL C string; no value follows.
+  GULLoggerArgumentTypeNullCString,
+};
+
+/// Returns the position just past the next conversion at or after `cursor` that consumes an
+/// argument, and sets `type` to the type of that argument and `precision` to its precision, or
+/// SIZE_MAX if it has none. Returns NULL if there is none.
+static const char *GULLoggerNextConversion(const char *cursor,
+                                           GULLoggerArgumentType *type,
+                                           size_t *precision) {
+  while ((cursor = strchr(cursor, '%'))) {
+    cursor++;
+    if (*cursor == '%') {
+      cursor++;
+      continue;
+    }
+
+    *type = GULLoggerArgumentTypeUnsupported;
+    *precision = SIZE_MAX;
+    const char *position = cursor + strspn(cursor, "0123456789");
+    if (*position == '$') {
+      return cursor;
+    }
+    cursor += strspn(cursor, "-+ #0'");
+    if (*cursor == '*') {
+      return cursor;
+    }
+    cursor += strspn(cursor, "0123456789");
+    if (*cursor == '.') {
+      cursor++;
+      if (*cursor == '*') {
+        return cursor;
+      }
+      *precision = 0;
+      for (; *cursor >= '0' && *cursor <= '9'; cursor++) {
+        // Precisions beyond the capacity are all equivalent here, so stop growing before overflow.
+        *precision = MIN(*precision * 10 + (size_t)(*cursor - '0'), (size_t)INT_MAX);
+      }
+    }
+
+    size_t integerSize = sizeof(int);
+    BOOL wide = NO;
+    BOOL longDouble = NO;
+    switch (*cursor) {
+      case 'h':
+        cursor += cursor[1] == 'h' ? 2 : 1;
+        break;
+      case 'l':
+        if (cursor[1] == 'l') {
+          integerSize = sizeof(long long);
+          cursor += 2;
+        } else {
+          integerSize = sizeof(long);
+          wide = YES;
+          cursor++;
+        }
+        break;
+      case 'q':
+        integerSize = sizeof(long long);
+        cursor++;
+        break;
+      case 'z':
+        integerSize = sizeof(size_t);
+        cursor++;
+        break;
+      case 't':
+        integerSize = sizeof(ptrdiff_t);
+        cursor++;
+        break;
+      case 'j':
+        integerSize = sizeof(intmax_t);
+        cursor++;
+        break;
+      case 'L':
+        longDouble = YES;
+        cursor++;
+        break;
+    }
+
+    switch (*cursor) {
+      case 'D':
+      case 'O':
+      case 'U':
+        *type = sizeof(long) == sizeof(int64_t) ? GULLoggerArgumentTypeInt64
+                                                : GULLoggerArgumentTypeInt32;
+        break;
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+        *type = integerSize == sizeof(int64_t) ? GULLoggerArgumentTypeInt64
+                                               : GULLoggerArgumentTypeInt32;
+        break;
+      case 'c':
+      case 'C':
+        *type = GULLoggerArgumentTypeInt32;
+        break;
+      case 'a':
+      case 'A':
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+        *type = longDouble ? GULLoggerArgumentTypeUnsupported : GULLoggerArgumentTypeDouble;
+        break;
+      case 's':
+        *type = wide ? GULLoggerArgumentTypeUnsupported : GULLoggerArgumentTypeCString;
+        break;
+      case 'p':
+        *type = GULLoggerArgumentTypePointer;
+        break;
+      case '@':
+        *type = GULLoggerArgumentTypeObject;
+        break;
+      default:
+        // `%n`, `%S`, unknown conversions and a truncated specification.
+        return cursor;
+    }
+    return cursor + 1;
+  }
+  return NULL;
+}
+
+/// Returns the number of bytes taken by `value`, the captured value of an argument of `type`.
+static size_t GULLoggerArgumentValueSize(GULLoggerArgumentType type, const uint8_t *value) {
+  switch (type) {
+    case GULLoggerArgumentTypeInt32:
+      return sizeof(int32_t);
+    case GULLoggerArgumentTypeInt64:
+      return sizeof(int64_t);
+    case GULLoggerArgumentTypeDouble:
+      return sizeof(double);
+    case GULLoggerArgumentTypePointer:
+    case GULLoggerArgumentTypeObject:
+      return sizeof(void *);
+    case GULLoggerArgumentTypeCString:
+      return 1 + (size_t)value[0] + 1;
+    case GULLoggerArgumentTypeUnsupported:
+    case GULLoggerArgumentTypeNullCString:
+      return 0;
+  }
+}
+
+/// Releases the objects among the captured arguments in `arguments`.
+static void GULLoggerArgumentsRelease(const uint8_t *arguments, size_t length) {
+  const uint8_t *argument = arguments;
+  while (argument < arguments + length) {
+    GULLoggerArgumentType type = *argument++;
+    if (type == GULLoggerArgumentTypeObject) {
+      const void *object;
+      memcpy(&object, argument, sizeof(object));
+      if (object) {
+        CFRelease(object);
+      }
+    }
+    argument += GULLoggerArgumentValueSize(type, argument);
+  }
+}
+
+/// Appends a tagged value to `arguments` if it fits.
+static BOOL GULLoggerArgumentsAppend(uint8_t *arguments,
+                                     size_t *length,
+                                     GULLoggerArgumentType type,
+                                     const void *value,
+                                     size_t valueSize) {
+  if (*length + 1 + valueSize > kGULLoggerCapturedArgumentsCapacity) {
+    return NO;
+  }
+  arguments[(*length)++] = type;
+  memcpy(arguments + *length, value, valueSize);
+  *length += valueSize;
+  return YES;
+}
+
+BOOL GULLoggerRecordCaptureArguments(GULLoggerRecord *record, NSString *format, va_list args) {
+  // Constant format strings expose their bytes directly; anything else is formatted eagerly. The
+  // copy keeps the bytes in place even if the caller mutates `format` afterwards.
+  format = [format copy];
+  const char *cursor = CFStringGetCStringPtr((__bridge CFStringRef)format, kCFStringEncodingUTF8);
+  if (!cursor) {
+    return NO;
+  }
+
+  uint8_t arguments[kGULLoggerCapturedArgumentsCapacity];
+  size_t length = 0;
+  BOOL captured = YES;
+  GULLoggerArgumentType type;
+  size_t precision;
+  va_list argsCopy;
+  va_copy(argsCopy, args);
+  while (captured && (cursor = GULLoggerNextConversion(cursor, &type, &precision))) {
+    switch (type) {
+      case GULLoggerArgumentTypeInt32: {
+        int32_t value = va_arg(argsCopy, int32_t);
+        captured = GULLoggerArgumentsAppend(arguments, &length, type, &value, sizeof(value));
+        break;
+      }
+      case GULLoggerArgumentTypeInt64: {
+        int64_t value = va_arg(argsCopy, int64_t);
+        captured = GULLoggerArgumentsAppend(arguments, &length, type, &value, sizeof(value));
+        break;
+      }
+      case GULLoggerArgumentTypeDouble: {
+        double value = va_arg(argsCopy, double);
+        captured = GULLoggerArgumentsAppend(arguments, &length, type, &value, sizeof(value));
+        break;
+      }
+      case GULLoggerArgumentTypePointer: {
+        void *value = va_arg(argsCopy, void *);
+        captured = GULLoggerArgumentsAppend(arguments, &length, type, &value, sizeof(value));
+        break;
+      }
+      case GULLoggerArgumentTypeObject: {
+        const void *value = va_arg(argsCopy, const void *);
+        captured = GULLoggerArgumentsAppend(arguments, &length, type, &value, sizeof(value));
+        if (captured && value) {
+          CFRetain(value);
+        }
+        break;
+      }
+      case GULLoggerArgumentTypeCString: {
+        const char *value = va_arg(argsCopy, const char *);
+        if (!value) {
+          captured = GULLoggerArgumentsAppend(arguments, &length,
+                                              GULLoggerArgumentTypeNullCString, NULL, 0);
+          break;
+        }
+        // With a precision, the argument need not be NUL-terminated, so read no further than it.
+        size_t stringLength = strnlen(value, precision);
+        uint8_t string[kGULLoggerCapturedArgumentsCapacity];
+        captured = stringLength + 2 <= sizeof(string);
+        if (captured) {
+          string[0] = (uint8_t)stringLength;
+          memcpy(string + 1, value, stringLength);
+          string[stringLength + 1] = '\0';
+          captured =
+              GULLoggerArgumentsAppend(arguments, &length, type, string, stringLength + 2);
+        }
+        break;
+      }
+      case GULLoggerArgumentTypeUnsupported:
+      case GULLoggerArgumentTypeNullCString:
+        captured = NO;
+        break;
+    }
+  }
+  va_end(argsCopy);
+
+  GULLoggerCapturedArguments *capturedArguments =
+      captured ? malloc(sizeof(GULLoggerCapturedArguments) + length) : NULL;
+  if (!capturedArguments) {
+    GULLoggerArgumentsRelease(arguments, length);
+    return NO;
+  }
+  capturedArguments->format = CFBridgingRetain(format);
+  capturedArguments->length = (uint8_t)length;
+  memcpy(capturedArguments->bytes, arguments, length);
+  record->arguments = capturedArguments;
+  return YES;
+}
+
+NSString *GULLoggerRecordMessage(const GULLoggerRecord *record) {
+  if (record->message) {
+    return (__bridge NSString *)record->message;
+  }
+  const GULLoggerCapturedArguments *capturedArguments = record->arguments;
+  if (!capturedArguments) {
+    return @"";
+  }
+
+  // The format was checked when the arguments were captured, so it can be trusted here.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"
+#pragma clang diagnostic ignored "-Wformat-security"
+  const char *segmentStart =
+      CFStringGetCStringPtr((CFStringRef)capturedArguments->format, kCFStringEncodingUTF8);
+  const char *segmentEnd;
+  const uint8_t *argument = capturedArguments->bytes;
+  NSMutableString *message = [NSMutableString string];
+  GULLoggerArgumentType conversionType;
+  size_t precision;
+  // Each segment holds literal text followed by one conversion, and is formatted with the argument
+  // captured for it.
+  while ((segmentEnd = GULLoggerNextConversion(segmentStart, &conversionType, &precision))) {
+    NSString *segment = [[NSString alloc] initWithBytes:segmentStart
+                                                 length:(NSUInteger)(segmentEnd - segmentStart)
+                                               encoding:NSUTF8StringEncoding];
+    GULLoggerArgumentType type = *argument++;
+    switch (type) {
+      case GULLoggerArgumentTypeInt32: {
+        int32_t value;
+        memcpy(&value, argument, sizeof(value));
+        [message appendFormat:segment, value];
+        break;
+      }
+      case GULLoggerArgumentTypeInt64: {
+        int64_t value;
+        memcpy(&value, argument, sizeof(value));
+        [message appendFormat:segment, value];
+        break;
+      }
+      case GULLoggerArgumentTypeDouble: {
+        double value;
+        memcpy(&value, argument, sizeof(value));
+        [message appendFormat:segment, value];
+        break;
+      }
+      case GULLoggerArgumentTypePointer: {
+        void *value;
+        memcpy(&value, argument, sizeof(value));
+        [message appendFormat:segment, value];
+        break;
+      }
+      case GULLoggerArgumentTypeObject: {
+        const void *value;
+        memcpy(&value, argument, sizeof(value));
+        [message appendFormat:segment, (__bridge id)value];
+        break;
+      }
+      case GULLoggerArgumentTypeCString:
+        [message appendFormat:segment, (const char *)argument + 1];
+        break;
+      case GULLoggerArgumentTypeNullCString:
+        [message appendFormat:segment, (const char *)NULL];
+        break;
+      case GULLoggerArgumentTypeUnsupported:
+        break;
+    }
+    argument += GULLoggerArgumentValueSize(type, argument);
+    segmentStart = segmentEnd;
+  }
+  if (*segmentStart) {
+    // The trailing literal text may still contain `%%`.
+    [message appendFormat:@(segmentStart)];
+  }
+#pragma clang diagnostic pop
+  return message;
+}
+
+void GULLoggerRecordReleaseArguments(GULLoggerRecord *record) {
+  GULLoggerCapturedArguments *capturedArguments = record->arguments;
+  if (!capturedArguments) {
+    return;
+  }
+  GULLoggerArgumentsRelease(capturedArguments->bytes, capturedArguments->length);
+  CFRelease(capturedArguments->format);
+  free(capturedArguments);
+  record->arguments = NULL;
+}
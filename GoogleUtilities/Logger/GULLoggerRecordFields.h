@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GoogleUtilities/Logger/GULLoggerBuffer.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Moves the first 255 of `fields` into a copy owned by `record`, and releases the objects held by
+/// any others.
+void GULLoggerRecordTakeFields(GULLoggerRecord *record,
+                               const GULLoggerField *_Nullable fields,
+                               NSUInteger fieldCount);
+
+/// Releases the objects held by `fields`.
+void GULLoggerFieldsRelease(const GULLoggerField *_Nullable fields, NSUInteger fieldCount);
+
+/// Returns the fields of `record` by key, as NSNumber, NSString, NSError or NSNull values, or nil
+/// if it has none.
+NSDictionary<NSString *, id> *_Nullable GULLoggerRecordFields(const GULLoggerRecord *record);
+
+/// Releases the fields of `record`.
+void GULLoggerRecordReleaseFields(GULLoggerRecord *record);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerRecordFields.h"
+
+void GULLoggerFieldsRelease(const GULLoggerField *fields, NSUInteger fieldCount) {
+  for (NSUInteger i = 0; i < fieldCount; i++) {
+    if ((fields[i].type == GULLoggerFieldTypeString || fields[i].type == GULLoggerFieldTypeError) &&
+        fields[i].value.objectValue) {
+      CFRelease(fields[i].value.objectValue);
+    }
+  }
+}
+
+void GULLoggerRecordTakeFields(GULLoggerRecord *record,
+                               const GULLoggerField *fields,
+                               NSUInteger fieldCount) {
+  NSUInteger keptCount = MIN(fieldCount, UINT8_MAX);
+  GULLoggerField *copiedFields =
+      keptCount > 0 ? malloc(keptCount * sizeof(GULLoggerField)) : NULL;
+  if (!copiedFields) {
+    GULLoggerFieldsRelease(fields, fieldCount);
+    return;
+  }
+  memcpy(copiedFields, fields, keptCount * sizeof(GULLoggerField));
+  GULLoggerFieldsRelease(fields + keptCount, fieldCount - keptCount);
+  record->fields = copiedFields;
+  record->fieldCount = (uint8_t)keptCount;
+}
+
+NSDictionary<NSString *, id> *GULLoggerRecordFields(const GULLoggerRecord *record) {
+  if (record->fieldCount == 0) {
+    return nil;
+  }
+  NSMutableDictionary<NSString *, id> *fields =
+      [NSMutableDictionary dictionaryWithCapacity:record->fieldCount];
+  for (uint8_t i = 0; i < record->fieldCount; i++) {
+    const GULLoggerField *field = &record->fields[i];
+    NSString *key = @(field->key);
+    id value;
+    switch (field->type) {
+      case GULLoggerFieldTypeInt64:
+        value = @(field->value.int64Value);
+        break;
+      case GULLoggerFieldTypeDouble:
+        value = @(field->value.doubleValue);
+        break;
+      case GULLoggerFieldTypeStaticString:
+        value = field->value.staticStringValue ? @(field->value.staticStringValue) : nil;
+        break;
+      case GULLoggerFieldTypeString:
+      case GULLoggerFieldTypeError:
+        value = (__bridge id)field->value.objectValue;
+        break;
+    }
+    if (key) {
+      fields[key] = value ?: [NSNull null];
+    }
+  }
+  return fields;
+}
+
+void GULLoggerRecordReleaseFields(GULLoggerRecord *record) {
+  if (!record->fields) {
+    return;
+  }
+  GULLoggerFieldsRelease(record->fields, record->fieldCount);
+  free(record->fields);
+  record->fields = NULL;
+  record->fieldCount = 0;
+}
@@ -0,0 +1,135 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/GULLoggerSinkInternal.h"
+
+#import <os/lock.h>
+
+#import "GoogleUtilities/Logger/GULLoggerBuffer.h"
+
+/// Guards `sGULLoggerSinks`.
+static os_unfair_lock sGULLoggerSinksLock = OS_UNFAIR_LOCK_INIT;
+
+/// The added sinks. Replaced rather than mutated, so a batch can be written to a snapshot without
+/// holding the lock.
+static NSArray<id<GULLoggerSink>> *sGULLoggerSinks;
+
+@implementation GULLoggerSinkRecord
+
+- (instancetype)initWithLevel:(GULLoggerLevel)level
+                    timestamp:(uint64_t)timestamp
+                    subsystem:(NSString *)subsystem
+                     category:(NSString *)category
+                  messageCode:(NSString *)messageCode
+                      message:(NSString *)message {
+  return [self initWithLevel:level
+                   timestamp:timestamp
+                   subsystem:subsystem
+                    category:category
+                 messageCode:messageCode
+                     message:message
+                      fields:nil];
+}
+
+- (instancetype)initWithLevel:(GULLoggerLevel)level
+                    timestamp:(uint64_t)timestamp
+                    subsystem:(NSString *)subsystem
+                     category:(NSString *)category
+                  messageCode:(NSString *)messageCode
+                      message:(NSString *)message
+                       fields:(NSDictionary<NSString *, id> *)fields {
+  self = [super init];
+  if (self) {
+    _level = level;
+    _timestamp = timestamp;
+    _subsystem = [subsystem copy];
+    _category = [category copy];
+    _messageCode = [messageCode copy];
+    _message = [message copy];
+    _fields = [fields copy] ?: @{};
+  }
+  return self;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p> %@[%@][%@] %@%@", [self class], self,
+                                    self.subsystem, self.category, self.messageCode, self.message,
+                                    GULLoggerFieldsDescription(self.fields)];
+}
+
+@end
+
+/// Returns the fields as ` key=value` pairs in key order, with strings quoted and errors shown as
+/// their domain and code.
+NSString *GULLoggerFieldsDescription(NSDictionary<NSString *, id> *fields) {
+  if (fields.count == 0) {
+    return @"";
+  }
+  NSMutableString *description = [NSMutableString string];
+  for (NSString *key in [fields.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+    id value = fields[key];
+    if ([value isKindOfClass:[NSError class]]) {
+      NSError *error = value;
+      [description appendFormat:@" %@=%@:%ld", key, error.domain, (long)error.code];
+    } else if ([value isKindOfClass:[NSString class]]) {
+      [description appendFormat:@" %@=\"%@\"", key, value];
+    } else if (value == [NSNull null]) {
+      [description appendFormat:@" %@=null", key];
+    } else {
+      [description appendFormat:@" %@=%@", key, value];
+    }
+  }
+  return description;
+}
+
+NSArray<id<GULLoggerSink>> *GULLoggerCurrentSinks(void) {
+  os_unfair_lock_lock(&sGULLoggerSinksLock);
+  NSArray<id<GULLoggerSink>> *sinks = sGULLoggerSinks;
+  os_unfair_lock_unlock(&sGULLoggerSinksLock);
+  return sinks;
+}
+
+void GULLoggerFlushSinks(void) {
+  for (id<GULLoggerSink> sink in GULLoggerCurrentSinks()) {
+    if ([sink respondsToSelector:@selector(flush)]) {
+      [sink flush];
+    }
+  }
+}
+
+#pragma mark - Public
+
+void GULLoggerAddSink(id<GULLoggerSink> sink) {
+  GULLoggerInitialize();
+  os_unfair_lock_lock(&sGULLoggerSinksLock);
+  if (!sGULLoggerSinks) {
+    sGULLoggerSinks = @[ sink ];
+  } else if ([sGULLoggerSinks indexOfObjectIdenticalTo:sink] == NSNotFound) {
+    sGULLoggerSinks = [sGULLoggerSinks arrayByAddingObject:sink];
+  }
+  os_unfair_lock_unlock(&sGULLoggerSinksLock);
+}
+
+void GULLoggerRemoveSink(id<GULLoggerSink> sink) {
+  GULLoggerInitialize();
+  os_unfair_lock_lock(&sGULLoggerSinksLock);
+  NSMutableArray<id<GULLoggerSink>> *sinks = [sGULLoggerSinks mutableCopy];
+  [sinks removeObjectIdenticalTo:sink];
+  sGULLoggerSinks = sinks.count > 0 ? [sinks copy] : nil;
+  os_unfair_lock_unlock(&sGULLoggerSinksLock);
+
+  // Wait out a batch that may still be writing to the sink.
+  GULLoggerBufferPerformOnDrainQueue(^{
+  });
+}
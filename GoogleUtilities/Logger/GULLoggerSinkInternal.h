@@ -0,0 +1,33 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns `fields` as ` key=value` pairs in key order, with strings quoted and errors shown as
+/// their domain and code, or an empty string if there are none.
+NSString *GULLoggerFieldsDescription(NSDictionary<NSString *, id> *_Nullable fields);
+
+/// Returns the sinks added with `GULLoggerAddSink`, or nil if there are none.
+NSArray<id<GULLoggerSink>> *_Nullable GULLoggerCurrentSinks(void);
+
+/// Calls `flush` on the sinks that implement it. Must be called on the logger's queue.
+void GULLoggerFlushSinks(void);
+
+NS_ASSUME_NONNULL_END
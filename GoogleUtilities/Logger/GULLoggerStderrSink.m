@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerStderrSink.h"
+
+#import <errno.h>
+#import <time.h>
+#import <unistd.h>
+
+#import "GoogleUtilities/Logger/GULLoggerSinkInternal.h"
+
+static const char *GULLoggerLevelName(GULLoggerLevel level) {
+  switch (level) {
+    case GULLoggerLevelError:
+      return "Error";
+    case GULLoggerLevelWarning:
+      return "Warning";
+    case GULLoggerLevelNotice:
+      return "Notice";
+    case GULLoggerLevelInfo:
+      return "Info";
+    case GULLoggerLevelDebug:
+      return "Debug";
+  }
+  return "Unknown";
+}
+
+@implementation GULLoggerStderrSink
+
+- (instancetype)init {
+  return [self initWithFileDescriptor:STDERR_FILENO];
+}
+
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor {
+  self = [super init];
+  if (self) {
+    _fileDescriptor = fileDescriptor;
+  }
+  return self;
+}
+
+#pragma mark - GULLoggerSink
+
+- (void)writeRecords:(NSArray<GULLoggerSinkRecord *> *)records {
+  NSMutableData *lines = [NSMutableData data];
+  for (GULLoggerSinkRecord *record in records) {
+    time_t seconds = (time_t)(record.timestamp / NSEC_PER_SEC);
+    struct tm time;
+    gmtime_r(&seconds, &time);
+    char timeString[32];
+    strftime(timeString, sizeof(timeString), "%Y-%m-%d %H:%M:%S", &time);
+
+    NSString *line = [NSString
+        stringWithFormat:@"%s.%03lluZ <%s> %@%@[%@] %@%@\n", timeString,
+                         (unsigned long long)(record.timestamp % NSEC_PER_SEC / NSEC_PER_MSEC),
+                         GULLoggerLevelName(record.level), record.subsystem, record.category,
+                         record.messageCode, record.message,
+                         GULLoggerFieldsDescription(record.fields)];
+    const char *utf8 = line.UTF8String;
+    [lines appendBytes:utf8 length:strlen(utf8)];
+  }
+
+  const uint8_t *bytes = lines.bytes;
+  NSUInteger remaining = lines.length;
+  while (remaining > 0) {
+    ssize_t written = write(self.fileDescriptor, bytes, remaining);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Nowhere to report the failure; the rest of the batch is lost.
+      return;
+    }
+    bytes += written;
+    remaining -= (NSUInteger)written;
+  }
+}
+
+@end
@@ -27,6 +27,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 typedef NSString *const GULLoggerService;
 
+/// An opaque handle for a subsystem and category, from `GULLoggerRegisterHandle`.
+typedef struct GULLoggerHandle GULLoggerHandle;
+
+/// The leading part of a `GULLoggerHandle` that is read inline by `GULLoggerHandleIsLoggable`. Not
+/// for direct use.
+typedef struct {
+  /// The least severe level currently logged through the handle, taking the global level, the
+  /// handle's own level and debug mode into account.
+  int loggableLevel;
+} GULLoggerHandleHeader;
+
+/// Returns whether messages of `level` are currently logged through `handle`, without a function
+/// call or lock.
+NS_INLINE BOOL GULLoggerHandleIsLoggable(GULLoggerHandle *handle, GULLoggerLevel level) {
+  // A handle starts with its header, so a pointer to one is a pointer to the other.
+  const GULLoggerHandleHeader *header = (const GULLoggerHandleHeader *)(void *)handle;
+  return (int)level <= __atomic_load_n(&header->loggableLevel, __ATOMIC_RELAXED);
+}
+
+/// What a logging call does when the calling thread's log buffer is full because the logger's
+/// queue has fallen behind.
+typedef NS_ENUM(NSInteger, GULLoggerBufferPolicy) {
+  /// The message is discarded and counted in `GULLoggerDroppedRecordCount()`. The default.
+  GULLoggerBufferPolicyDrop = 0,
+  /// The call waits until the logger's queue has made room.
+  GULLoggerBufferPolicyBlock,
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
@@ -50,6 +78,24 @@ extern GULLoggerLevel GULGetLoggerLevel(void);
  */
 extern void GULSetLoggerLevel(GULLoggerLevel loggerLevel);
 
+/**
+ * Sets the maximum level logged for one subsystem and category, e.g. to turn on debug logging for
+ * a single component, in place of the level set with `GULSetLoggerLevel`. Also applies to messages
+ * logged through a handle for the category. The same App Store restriction applies.
+ * (required) subsystem, e.g. kGULLogSubsystem.
+ * (required) category name within the subsystem.
+ * (required) log level (one of the GULLoggerLevel enum values).
+ */
+extern void GULLoggerSetCategoryLevel(NSString *subsystem,
+                                      NSString *category,
+                                      GULLoggerLevel loggerLevel);
+
+/**
+ * Removes the level set for a subsystem and category with `GULLoggerSetCategoryLevel` or
+ * `GULLoggerHandleSetLevel`, so that it follows the level set with `GULSetLoggerLevel` again.
+ */
+extern void GULLoggerClearCategoryLevel(NSString *subsystem, NSString *category);
+
 /**
  * Checks if the specified logger level is loggable given the current settings.
  * (required) log level (one of the GULLoggerLevel enum values).
@@ -62,6 +108,53 @@ extern BOOL GULIsLoggableLevel(GULLoggerLevel loggerLevel);
  */
 extern void GULLoggerRegisterVersion(NSString *version);
 
+/**
+ * Messages are collected in a buffer per logging thread and written to the log in batches on a
+ * background queue. Sets what happens when a thread's buffer is full. Records logged from the
+ * logger's own queue are written immediately and never wait. Records logged on the thread that is
+ * writing a batch, e.g. by a sink that hops to its own queue, never wait either and are dropped
+ * when that thread's buffer is full.
+ */
+extern void GULLoggerSetBufferPolicy(GULLoggerBufferPolicy policy);
+
+/**
+ * Sets the number of messages each thread can buffer, rounded up to a power of two. Applies to
+ * threads that log for the first time after the call. Defaults to 256.
+ */
+extern void GULLoggerSetBufferCapacity(NSUInteger capacity);
+
+/// Returns the number of messages dropped because a thread's buffer was full.
+extern uint64_t GULLoggerDroppedRecordCount(void);
+
+/// Waits until every message logged before the call has been written to the log and passed to the
+/// sinks added with `GULLoggerAddSink`, then flushes the sinks. Called from a sink's
+/// `writeRecords:`, it only flushes the sinks; the messages still buffered follow once that call
+/// returns.
+extern void GULLoggerFlush(void);
+
+/**
+ * Limits how often messages with a code starting with `messageCodePrefix` are logged, e.g. @"I-NET"
+ * or @"I-SWZ000010". Each message code gets a token bucket that holds up to `burst` messages and
+ * refills at `messagesPerSecond`. Messages over the limit are discarded before they are formatted,
+ * and the number discarded per code is logged every 10 seconds with code I-COR000025. When several
+ * prefixes match a code, the longest one applies. Replaces any limit set for the same prefix.
+ */
+extern void GULLoggerSetRateLimit(NSString *messageCodePrefix,
+                                  double messagesPerSecond,
+                                  NSUInteger burst);
+
+/// Removes the rate limit set for `messageCodePrefix` with `GULLoggerSetRateLimit`.
+extern void GULLoggerRemoveRateLimit(NSString *messageCodePrefix);
+
+/**
+ * When enabled, logging calls with a constant format string only copy the raw arguments, and the
+ * message is formatted later on the logger's queue, or not at all if it is dropped. Objects passed
+ * for `%@` are retained and described on that queue, so only enable this if they are not mutated
+ * after being logged. Formats with `*` widths, positional or wide arguments, or more arguments
+ * than fit in a record are still formatted by the caller. Disabled by default.
+ */
+extern void GULLoggerSetDeferredFormatting(BOOL deferredFormatting);
+
 /**
  * Logs a message to the Xcode console and the device log. If running from AppStore, will
  * not log any messages with a level higher than GULLoggerLevelNotice to avoid log spamming.
@@ -134,10 +227,157 @@ extern void GULOSLogDebug(NSString *subsystem,
                           NSString *message,
                           ...) NS_FORMAT_FUNCTION(5, 6);
 
+/**
+ * Returns the handle for a subsystem and category, registering them on first use. Handles hold the
+ * `os_log_t` and level of their category and live for the rest of the process, so they are best
+ * registered once and kept, e.g. in a static variable. Logging through a handle avoids looking up
+ * the category by name on every call. Only this function and `GULLoggerSetCategoryLevel` register
+ * handles without limit; logging by name registers at most 64.
+ * (required) subsystem, e.g. kGULLogSubsystem.
+ * (required) category name within the subsystem, e.g. @"[GULReachability]".
+ */
+extern GULLoggerHandle *GULLoggerRegisterHandle(NSString *subsystem, NSString *category);
+
+/**
+ * Sets the maximum level logged for the category of `handle`, which otherwise follows the level
+ * set with `GULSetLoggerLevel`. The same App Store restriction applies.
+ */
+extern void GULLoggerHandleSetLevel(GULLoggerHandle *handle, GULLoggerLevel loggerLevel);
+
+/**
+ * Like `GULOSLogBasic`, but for the subsystem and category of a registered handle.
+ */
+extern void GULLoggerLogBasic(GULLoggerHandle *handle,
+                              GULLoggerLevel level,
+                              BOOL forceLog,
+                              NSString *messageCode,
+                              NSString *message,
+#if __LP64__ && TARGET_OS_SIMULATOR || TARGET_OS_OSX
+                              va_list args_ptr
+#else
+                              va_list _Nullable args_ptr
+#endif
+);
+
+/**
+ * Like the `GULOSLog` functions, but for the subsystem and category of a registered handle.
+ * Example usage:
+ * static GULLoggerHandle *handle;
+ * static dispatch_once_t onceToken;
+ * dispatch_once(&onceToken, ^{
+ *   handle = GULLoggerRegisterHandle(kGULLogSubsystem, @"[GoogleUtilities/Example]");
+ * });
+ * GULLoggerLogError(handle, NO, @"I-COR000001", @"Configuration of %@ failed.", app.name);
+ */
+extern void GULLoggerLogError(GULLoggerHandle *handle,
+                              BOOL force,
+                              NSString *messageCode,
+                              NSString *message,
+                              ...) NS_FORMAT_FUNCTION(4, 5);
+extern void GULLoggerLogWarning(GULLoggerHandle *handle,
+                                BOOL force,
+                                NSString *messageCode,
+                                NSString *message,
+                                ...) NS_FORMAT_FUNCTION(4, 5);
+extern void GULLoggerLogNotice(GULLoggerHandle *handle,
+                               BOOL force,
+                               NSString *messageCode,
+                               NSString *message,
+                               ...) NS_FORMAT_FUNCTION(4, 5);
+extern void GULLoggerLogInfo(GULLoggerHandle *handle,
+                             BOOL force,
+                             NSString *messageCode,
+                             NSString *message,
+                             ...) NS_FORMAT_FUNCTION(4, 5);
+extern void GULLoggerLogDebug(GULLoggerHandle *handle,
+                              BOOL force,
+                              NSString *messageCode,
+                              NSString *message,
+                              ...) NS_FORMAT_FUNCTION(4, 5);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
 
+/**
+ * The least severe level compiled into a build by the `GUL_LOG_*` macros, as the value of a
+ * `GULLoggerLevel` from 3 (`GULLoggerLevelError`) to 7 (`GULLoggerLevelDebug`). Calls to the macros
+ * for less severe levels compile to nothing and their arguments are not evaluated, even for forced
+ * messages. Defaults to 7, which keeps every level; building with e.g.
+ * `GUL_LOG_MIN_LEVEL=5` removes Info and Debug messages.
+ */
+#ifndef GUL_LOG_MIN_LEVEL
+#define GUL_LOG_MIN_LEVEL 7
+#endif  // GUL_LOG_MIN_LEVEL
+
+/// Calls `function` only if the message is forced or its level is currently logged through
+/// `handle`, so that the arguments are not evaluated otherwise.
+#define GUL_LOG_IF_LOGGABLE(function, level, handle, force, messageCode, ...)    \
+  do {                                                                           \
+    GULLoggerHandle *gul_log_handle_ = (handle);                                 \
+    BOOL gul_log_force_ = (force);                                               \
+    if (gul_log_force_ || GULLoggerHandleIsLoggable(gul_log_handle_, (level))) { \
+      function(gul_log_handle_, gul_log_force_, (messageCode), __VA_ARGS__);     \
+    }                                                                            \
+  } while (0)
+
+/**
+ * Logs through a registered handle, like the `GULLoggerLog*` functions, but checks the level inline
+ * before evaluating the message code and arguments, and compiles to nothing for levels excluded by
+ * `GUL_LOG_MIN_LEVEL`. Takes the handle, whether to force the message, the message code and the
+ * message format followed by its arguments.
+ * Example usage:
+ * GUL_LOG_DEBUG(handle, NO, @"I-COR000001", @"Configured %@.", app.name);
+ */
+#if GUL_LOG_MIN_LEVEL >= 3
+#define GUL_LOG_ERROR(handle, force, messageCode, ...)                                    \
+  GUL_LOG_IF_LOGGABLE(GULLoggerLogError, GULLoggerLevelError, handle, force, messageCode, \
+                      __VA_ARGS__)
+#else
+#define GUL_LOG_ERROR(handle, force, messageCode, ...) \
+  do {                                                 \
+  } while (0)
+#endif
+
+#if GUL_LOG_MIN_LEVEL >= 4
+#define GUL_LOG_WARNING(handle, force, messageCode, ...)                                     \
+  GUL_LOG_IF_LOGGABLE(GULLoggerLogWarning, GULLoggerLevelWarning, handle, force, messageCode, \
+                      __VA_ARGS__)
+#else
+#define GUL_LOG_WARNING(handle, force, messageCode, ...) \
+  do {                                                   \
+  } while (0)
+#endif
+
+#if GUL_LOG_MIN_LEVEL >= 5
+#define GUL_LOG_NOTICE(handle, force, messageCode, ...)                                    \
+  GUL_LOG_IF_LOGGABLE(GULLoggerLogNotice, GULLoggerLevelNotice, handle, force, messageCode, \
+                      __VA_ARGS__)
+#else
+#define GUL_LOG_NOTICE(handle, force, messageCode, ...) \
+  do {                                                  \
+  } while (0)
+#endif
+
+#if GUL_LOG_MIN_LEVEL >= 6
+#define GUL_LOG_INFO(handle, force, messageCode, ...) \
+  GUL_LOG_IF_LOGGABLE(GULLoggerLogInfo, GULLoggerLevelInfo, handle, force, messageCode, __VA_ARGS__)
+#else
+#define GUL_LOG_INFO(handle, force, messageCode, ...) \
+  do {                                                \
+  } while (0)
+#endif
+
+#if GUL_LOG_MIN_LEVEL >= 7
+#define GUL_LOG_DEBUG(handle, force, messageCode, ...)                                    \
+  GUL_LOG_IF_LOGGABLE(GULLoggerLogDebug, GULLoggerLevelDebug, handle, force, messageCode, \
+                      __VA_ARGS__)
+#else
+#define GUL_LOG_DEBUG(handle, force, messageCode, ...) \
+  do {                                                 \
+  } while (0)
+#endif
+
 @interface GULLoggerWrapper : NSObject
 
 /// Objective-C wrapper for `GULOSLogBasic` to allow weak linking to `GULLogger`.
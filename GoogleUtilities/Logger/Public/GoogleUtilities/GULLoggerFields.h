@@ -0,0 +1,140 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GULLogger.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The type of the value of a `GULLoggerField`.
+typedef NS_ENUM(uint8_t, GULLoggerFieldType) {
+  GULLoggerFieldTypeInt64 = 0,
+  GULLoggerFieldTypeDouble,
+  /// A C string that lives for the rest of the process, e.g. a literal. It is not copied.
+  GULLoggerFieldTypeStaticString,
+  GULLoggerFieldTypeString,
+  GULLoggerFieldTypeError,
+};
+
+/// A typed key/value pair logged with `GULLoggerLogFields`. Create fields with the
+/// `GULLoggerField*` functions below rather than directly, and pass every field created to
+/// `GULLoggerLogFields`, which releases the objects they hold.
+typedef struct {
+  /// A C string that lives for the rest of the process, e.g. a literal.
+  const char *key;
+  GULLoggerFieldType type;
+  union {
+    int64_t int64Value;
+    double doubleValue;
+    const char *_Nullable staticStringValue;
+    /// An NSString or NSError, retained by the field, or NULL.
+    CFTypeRef _Nullable objectValue;
+  } value;
+} GULLoggerField;
+
+// The fields are assigned one by one rather than with designated initializers, which C++ only
+// supports since C++20 and without nesting, so that the header also compiles as Objective-C++.
+
+NS_INLINE GULLoggerField GULLoggerFieldInt64(const char *key, int64_t value) {
+  GULLoggerField field = {0};
+  field.key = key;
+  field.type = GULLoggerFieldTypeInt64;
+  field.value.int64Value = value;
+  return field;
+}
+
+NS_INLINE GULLoggerField GULLoggerFieldDouble(const char *key, double value) {
+  GULLoggerField field = {0};
+  field.key = key;
+  field.type = GULLoggerFieldTypeDouble;
+  field.value.doubleValue = value;
+  return field;
+}
+
+NS_INLINE GULLoggerField GULLoggerFieldStaticString(const char *key, const char *_Nullable value) {
+  GULLoggerField field = {0};
+  field.key = key;
+  field.type = GULLoggerFieldTypeStaticString;
+  field.value.staticStringValue = value;
+  return field;
+}
+
+/// Copies `value`, which for an immutable string only retains it.
+NS_INLINE GULLoggerField GULLoggerFieldString(const char *key, NSString *_Nullable value) {
+  GULLoggerField field = {0};
+  field.key = key;
+  field.type = GULLoggerFieldTypeString;
+  field.value.objectValue = value ? CFBridgingRetain([value copy]) : NULL;
+  return field;
+}
+
+/// Retains `value`. Sinks get the error itself, and `os_log` shows its domain and code.
+NS_INLINE GULLoggerField GULLoggerFieldError(const char *key, NSError *_Nullable value) {
+  GULLoggerField field = {0};
+  field.key = key;
+  field.type = GULLoggerFieldTypeError;
+  field.value.objectValue = value ? CFBridgingRetain(value) : NULL;
+  return field;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Logs a constant message with typed fields through a registered handle, without formatting a
+ * string on the calling thread. The fields are kept in the log record as they are: `os_log` shows
+ * them after the message as `key=value` pairs, and sinks get them in
+ * `GULLoggerSinkRecord.fields` to render or serialize themselves. Takes ownership of the objects
+ * held by `fields`, whether or not the message is logged. Prefer `GUL_LOG_FIELDS`, which does not
+ * create the fields unless the message is logged.
+ */
+extern void GULLoggerLogFields(GULLoggerHandle *handle,
+                               GULLoggerLevel level,
+                               BOOL force,
+                               NSString *messageCode,
+                               NSString *message,
+                               const GULLoggerField *_Nullable fields,
+                               NSUInteger fieldCount);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+/**
+ * Logs a message with fields through a registered handle, checking the level inline before the
+ * fields are created. Takes the handle, level, whether to force the message, the message code, a
+ * constant message and at least one field.
+ * Example usage:
+ * GUL_LOG_FIELDS(handle, GULLoggerLevelWarning, NO, @"I-NET000001", @"Request failed.",
+ *                GULLoggerFieldInt64("status", response.statusCode),
+ *                GULLoggerFieldError("error", error));
+ */
+#define GUL_LOG_FIELDS(handle, level, force, messageCode, message, ...)                  \
+  do {                                                                                   \
+    GULLoggerHandle *gul_log_handle_ = (handle);                                         \
+    GULLoggerLevel gul_log_level_ = (level);                                             \
+    BOOL gul_log_force_ = (force);                                                       \
+    if (gul_log_force_ || GULLoggerHandleIsLoggable(gul_log_handle_, gul_log_level_)) {  \
+      const GULLoggerField gul_log_fields_[] = {__VA_ARGS__};                            \
+      GULLoggerLogFields(gul_log_handle_, gul_log_level_, gul_log_force_, (messageCode), \
+                         (message), gul_log_fields_,                                     \
+                         sizeof(gul_log_fields_) / sizeof(gul_log_fields_[0]));          \
+    }                                                                                    \
+  } while (0)
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GULLoggerSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Keeps log messages in a bounded set of binary files in a directory, e.g. to attach them to bug
+/// reports.
+///
+/// Each file is allocated at its full size up front and written through a shared memory mapping,
+/// so a batch is written with plain memory copies and what was written survives a crash of the
+/// process. When a file is full, a new one is started and the oldest is deleted once there are
+/// more than `maximumFileCount`. Records are length-prefixed and read back with
+/// `recordsInFileAtPath:error:`. Only uses POSIX and Foundation, so it also works in tests off
+/// Apple platforms.
+///
+/// Meant to be added with `GULLoggerAddSink`; its methods must not be called concurrently.
+@interface GULLoggerFileSink : NSObject <GULLoggerSink>
+
+@property(nonatomic, copy, readonly) NSString *directory;
+
+/// The size of each file, a multiple of the page size.
+@property(nonatomic, readonly) NSUInteger maximumFileSize;
+
+@property(nonatomic, readonly) NSUInteger maximumFileCount;
+
+/// The paths of the files in `directory`, oldest first.
+@property(nonatomic, readonly) NSArray<NSString *> *filePaths;
+
+/// The number of messages that were not written, because they were too large to fit in a file or a
+/// new file could not be created.
+@property(nonatomic, readonly) NSUInteger skippedRecordCount;
+
+/// Reads the records in a file written by a `GULLoggerFileSink`, including one that is still being
+/// written or was left behind by a crash.
++ (nullable NSArray<GULLoggerSinkRecord *> *)recordsInFileAtPath:(NSString *)path
+                                                          error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Creates `directory` if needed and starts a new file in it, after any left by a previous sink.
+/// `maximumFileSize` is rounded up to a multiple of the page size, and `maximumFileCount` is at
+/// least 1.
+- (nullable instancetype)initWithDirectory:(NSString *)directory
+                           maximumFileSize:(NSUInteger)maximumFileSize
+                          maximumFileCount:(NSUInteger)maximumFileCount
+                                     error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GULLoggerLevel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A logged message, as passed to a `GULLoggerSink`.
+@interface GULLoggerSinkRecord : NSObject
+
+@property(nonatomic, readonly) GULLoggerLevel level;
+
+/// When the message was logged, in nanoseconds since 1970.
+@property(nonatomic, readonly) uint64_t timestamp;
+
+@property(nonatomic, copy, readonly) NSString *subsystem;
+
+@property(nonatomic, copy, readonly) NSString *category;
+
+@property(nonatomic, copy, readonly) NSString *messageCode;
+
+/// The formatted message, without the version, category and message code that `os_log` messages
+/// are prefixed with.
+@property(nonatomic, copy, readonly) NSString *message;
+
+/// The fields of a message logged with `GULLoggerLogFields`, by key, or an empty dictionary. Values
+/// are NSNumber for integers and doubles, NSString for strings, NSError for errors and NSNull for
+/// nil strings and errors.
+@property(nonatomic, copy, readonly) NSDictionary<NSString *, id> *fields;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithLevel:(GULLoggerLevel)level
+                    timestamp:(uint64_t)timestamp
+                    subsystem:(NSString *)subsystem
+                     category:(NSString *)category
+                  messageCode:(NSString *)messageCode
+                      message:(NSString *)message;
+
+- (instancetype)initWithLevel:(GULLoggerLevel)level
+                    timestamp:(uint64_t)timestamp
+                    subsystem:(NSString *)subsystem
+                     category:(NSString *)category
+                  messageCode:(NSString *)messageCode
+                      message:(NSString *)message
+                       fields:(nullable NSDictionary<NSString *, id> *)fields
+    NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/// A destination for log messages in addition to `os_log`, added with `GULLoggerAddSink`.
+///
+/// Sinks are called on the logger's serial queue with the messages that were logged since the last
+/// batch, in the order they were logged on each thread, so logging calls never wait for a sink.
+/// Messages logged by a sink from one of its methods are written to `os_log` only.
+@protocol GULLoggerSink <NSObject>
+
+/// Writes a batch of messages.
+- (void)writeRecords:(NSArray<GULLoggerSinkRecord *> *)records;
+
+@optional
+
+/// Writes out anything the sink buffers. Called by `GULLoggerFlush`.
+- (void)flush;
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/// Starts passing logged messages to `sink`, which is retained until it is removed. Adding a sink
+/// twice has no effect.
+extern void GULLoggerAddSink(id<GULLoggerSink> sink);
+
+/// Stops passing logged messages to `sink`. Waits for a batch that is being written to finish, so
+/// the sink is not called after this returns, unless it is called from the sink itself.
+extern void GULLoggerRemoveSink(id<GULLoggerSink> sink);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+NS_ASSUME_NONNULL_END
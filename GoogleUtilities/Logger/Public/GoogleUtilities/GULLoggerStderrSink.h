@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GULLoggerSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Writes log messages as lines of text to standard error, or another file descriptor, for hosts
+/// without unified logging such as command line tools and test harnesses. Each batch is written
+/// with as few `write` calls as possible. Lines look like:
+/// 2026-01-31 12:00:00.000Z <Error> com.google.utilities.logger[GULLogger][I-COR000001] Message
+/// followed by any fields as ` key=value` pairs.
+@interface GULLoggerStderrSink : NSObject <GULLoggerSink>
+
+/// The file descriptor written to. It is not closed by the sink.
+@property(nonatomic, readonly) int fileDescriptor;
+
+/// Initializes a sink that writes to `STDERR_FILENO`.
+- (instancetype)init;
+
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
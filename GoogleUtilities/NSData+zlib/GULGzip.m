@@ -0,0 +1,536 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULGzip.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+#import <zlib.h>
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibInternal.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+
+const NSUInteger GULGzipDefaultWindowSize = 64 * 1024;
+
+/// The smallest accepted output window. zlib needs a few bytes of room to make progress.
+static const NSUInteger kGULGzipMinimumWindowSize = 64;
+
+/// How much of a mapped source file is compressed before its pages are released. A multiple of the
+/// page size on every platform.
+static const NSUInteger kGULGzipFileSliceSize = 8 * 1024 * 1024;
+
+static NSError *GULGzipWriteError(NSError *_Nullable underlyingError) {
+  NSDictionary *userInfo = underlyingError ? @{NSUnderlyingErrorKey : underlyingError} : @{};
+  return [NSError errorWithDomain:GULNSDataZlibErrorDomain
+                             code:GULNSDataZlibErrorOutputWriteFailed
+                         userInfo:userInfo];
+}
+
+static NSError *GULGzipReadError(int posixError) {
+  NSError *underlyingError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                                 code:posixError
+                                             userInfo:nil];
+  return [NSError errorWithDomain:GULNSDataZlibErrorDomain
+                             code:GULNSDataZlibErrorInputReadFailed
+                         userInfo:@{NSUnderlyingErrorKey : underlyingError}];
+}
+
+static NSError *GULGzipFinishedError(void) {
+  return [NSError errorWithDomain:GULNSDataZlibErrorDomain
+                             code:GULNSDataZlibErrorStreamFinished
+                         userInfo:nil];
+}
+
+#pragma mark - GULGzipOutput
+
+/// Owns the output window shared by the encoder and decoder and forwards filled windows to the
+/// destination they were created with.
+@interface GULGzipOutput : NSObject
+
+@property(nonatomic, readonly) NSUInteger windowSize;
+
+@property(nonatomic, readonly) unsigned char *window;
+
+@property(nonatomic, readonly) uint64_t totalBytesOut;
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(nullable GULGzipOutputHandler)outputHandler
+                      outputStream:(nullable NSOutputStream *)outputStream
+                    fileDescriptor:(int)fileDescriptor;
+
+/// Forwards the first `length` bytes of the window to the destination.
+- (BOOL)emitWindowBytes:(NSUInteger)length error:(NSError **)error;
+
+@end
+
+@implementation GULGzipOutput {
+  GULGzipOutputHandler _outputHandler;
+  NSOutputStream *_outputStream;
+  int _fileDescriptor;
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler
+                      outputStream:(NSOutputStream *)outputStream
+                    fileDescriptor:(int)fileDescriptor {
+  self = [super init];
+  if (self) {
+    if (windowSize == 0) {
+      windowSize = GULGzipDefaultWindowSize;
+    }
+    // zlib counts available output with a 32-bit unsigned int.
+    _windowSize = MIN(MAX(windowSize, kGULGzipMinimumWindowSize), (NSUInteger)UINT_MAX);
+    _window = malloc(_windowSize);
+    if (!_window) {
+      return nil;
+    }
+    _outputHandler = [outputHandler copy];
+    _outputStream = outputStream;
+    _fileDescriptor = fileDescriptor;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_window);
+}
+
+- (BOOL)emitWindowBytes:(NSUInteger)length error:(NSError **)error {
+  if (length == 0) {
+    return YES;
+  }
+
+  if (_outputHandler) {
+    if (!_outputHandler([NSData dataWithBytes:_window length:length])) {
+      if (error) {
+        *error = GULGzipWriteError(nil);
+      }
+      return NO;
+    }
+  } else if (_outputStream) {
+    NSUInteger offset = 0;
+    while (offset < length) {
+      NSInteger written = [_outputStream write:_window + offset maxLength:length - offset];
+      if (written <= 0) {
+        if (error) {
+          *error = GULGzipWriteError(_outputStream.streamError);
+        }
+        return NO;
+      }
+      offset += (NSUInteger)written;
+    }
+  } else {
+    NSUInteger offset = 0;
+    while (offset < length) {
+      ssize_t written = write(_fileDescriptor, _window + offset, length - offset);
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      if (written <= 0) {
+        if (error) {
+          *error = GULGzipWriteError([NSError errorWithDomain:NSPOSIXErrorDomain
+                                                         code:errno
+                                                     userInfo:nil]);
+        }
+        return NO;
+      }
+      offset += (NSUInteger)written;
+    }
+  }
+
+  _totalBytesOut += length;
+  return YES;
+}
+
+@end
+
+#pragma mark - GULGzipEncoder
+
+@implementation GULGzipEncoder {
+  GULGzipOutput *_output;
+  z_stream _stream;
+  BOOL _finished;
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:outputHandler
+                     outputStream:nil
+                   fileDescriptor:-1];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                      outputStream:(NSOutputStream *)outputStream {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:nil
+                     outputStream:outputStream
+                   fileDescriptor:-1];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize fileDescriptor:(int)fileDescriptor {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:nil
+                     outputStream:nil
+                   fileDescriptor:fileDescriptor];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler
+                      outputStream:(NSOutputStream *)outputStream
+                    fileDescriptor:(int)fileDescriptor {
+  self = [super init];
+  if (self) {
+    _output = [[GULGzipOutput alloc] initWithWindowSize:windowSize
+                                          outputHandler:outputHandler
+                                           outputStream:outputStream
+                                         fileDescriptor:fileDescriptor];
+    if (!_output) {
+      return nil;
+    }
+
+    bzero(&_stream, sizeof(z_stream));
+    int memLevel = 8;          // Default.
+    int windowBits = 15 + 16;  // Enable gzip header instead of zlib header.
+    if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, memLevel,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  deflateEnd(&_stream);
+}
+
+- (NSUInteger)windowSize {
+  return _output.windowSize;
+}
+
+- (uint64_t)totalBytesIn {
+  return _stream.total_in;
+}
+
+- (uint64_t)totalBytesOut {
+  return _output.totalBytesOut;
+}
+
+- (uint32_t)crc32 {
+  // With gzip framing, zlib keeps the running CRC-32 in the adler field.
+  return (uint32_t)_stream.adler;
+}
+
++ (BOOL)gzipFileAtPath:(NSString *)sourcePath
+      toFileDescriptor:(int)fileDescriptor
+        compressedSize:(uint64_t *)compressedSize
+                 crc32:(uint32_t *)crc
+                 error:(NSError **)error {
+  int sourceDescriptor = open(sourcePath.fileSystemRepresentation, O_RDONLY | O_CLOEXEC);
+  if (sourceDescriptor < 0) {
+    if (error) {
+      *error = GULGzipReadError(errno);
+    }
+    return NO;
+  }
+  struct stat sourceStat;
+  if (fstat(sourceDescriptor, &sourceStat) != 0) {
+    int posixError = errno;
+    close(sourceDescriptor);
+    if (error) {
+      *error = GULGzipReadError(posixError);
+    }
+    return NO;
+  }
+
+  if ((unsigned long long)sourceStat.st_size > NSUIntegerMax) {
+    close(sourceDescriptor);
+    if (error) {
+      *error = GULGzipReadError(EFBIG);
+    }
+    return NO;
+  }
+  NSUInteger length = (NSUInteger)sourceStat.st_size;
+  unsigned char *mapped = NULL;
+  if (length > 0) {
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, sourceDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+      int posixError = errno;
+      close(sourceDescriptor);
+      if (error) {
+        *error = GULGzipReadError(posixError);
+      }
+      return NO;
+    }
+    mapped = mapping;
+    madvise(mapped, length, MADV_SEQUENTIAL);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(sourceDescriptor);
+
+  GULGzipEncoder *encoder = [[self alloc] initWithWindowSize:0 fileDescriptor:fileDescriptor];
+  BOOL success = encoder != nil;
+  if (!success && error) {
+    *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, Z_MEM_ERROR, NULL);
+  }
+  for (NSUInteger offset = 0; success && offset < length; offset += kGULGzipFileSliceSize) {
+    NSUInteger sliceLength = MIN(kGULGzipFileSliceSize, length - offset);
+    success = [encoder appendBytes:mapped + offset length:sliceLength error:error];
+    // The compressed pages are clean and file backed, so they can be dropped right away instead of
+    // accumulating in the resident set.
+    madvise(mapped + offset, sliceLength, MADV_DONTNEED);
+  }
+  success = success && [encoder finishWithError:error];
+  if (mapped) {
+    munmap(mapped, length);
+  }
+
+  if (success) {
+    if (compressedSize) {
+      *compressedSize = encoder.totalBytesOut;
+    }
+    if (crc) {
+      *crc = encoder.crc32;
+    }
+  }
+  return success;
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+  return [self appendBytes:data.bytes length:data.length error:error];
+}
+
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError **)error {
+  if (_finished) {
+    if (error) {
+      *error = GULGzipFinishedError();
+    }
+    return NO;
+  }
+  return [self deflateBytes:bytes length:length flush:Z_NO_FLUSH error:error];
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+  if (_finished) {
+    if (error) {
+      *error = GULGzipFinishedError();
+    }
+    return NO;
+  }
+  _finished = YES;
+  return [self deflateBytes:NULL length:0 flush:Z_FINISH error:error];
+}
+
+/// Feeds the input to zlib in 32-bit windows and emits every output window it fills.
+- (BOOL)deflateBytes:(const unsigned char *)bytes
+              length:(NSUInteger)length
+               flush:(int)flush
+               error:(NSError **)error {
+  do {
+    uInt inputWindow = (uInt)MIN(length, (NSUInteger)UINT_MAX);
+    _stream.next_in = (Bytef *)bytes;
+    _stream.avail_in = inputWindow;
+    if (inputWindow > 0) {
+      bytes += inputWindow;
+      length -= inputWindow;
+    }
+    int windowFlush = length > 0 ? Z_NO_FLUSH : flush;
+
+    do {
+      _stream.next_out = _output.window;
+      _stream.avail_out = (uInt)_output.windowSize;
+      int retCode = deflate(&_stream, windowFlush);
+      if (retCode == Z_STREAM_ERROR) {
+        if (error) {
+          *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, &_stream);
+        }
+        return NO;
+      }
+      if (![_output emitWindowBytes:_output.windowSize - _stream.avail_out error:error]) {
+        return NO;
+      }
+    } while (_stream.avail_out == 0);
+  } while (length > 0);
+
+  return YES;
+}
+
+@end
+
+#pragma mark - GULGzipDecoder
+
+@implementation GULGzipDecoder {
+  GULGzipOutput *_output;
+  z_stream _stream;
+  BOOL _finished;
+
+  /// Whether the last member ended exactly at the end of the input seen so far.
+  BOOL _atMemberBoundary;
+
+  /// Input consumed by the members before the current one. `inflateReset` zeroes `total_in`.
+  uint64_t _completedMembersBytesIn;
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:outputHandler
+                     outputStream:nil
+                   fileDescriptor:-1];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                      outputStream:(NSOutputStream *)outputStream {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:nil
+                     outputStream:outputStream
+                   fileDescriptor:-1];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize fileDescriptor:(int)fileDescriptor {
+  return [self initWithWindowSize:windowSize
+                    outputHandler:nil
+                     outputStream:nil
+                   fileDescriptor:fileDescriptor];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler
+                      outputStream:(NSOutputStream *)outputStream
+                    fileDescriptor:(int)fileDescriptor {
+  self = [super init];
+  if (self) {
+    _output = [[GULGzipOutput alloc] initWithWindowSize:windowSize
+                                          outputHandler:outputHandler
+                                           outputStream:outputStream
+                                         fileDescriptor:fileDescriptor];
+    if (!_output) {
+      return nil;
+    }
+
+    bzero(&_stream, sizeof(z_stream));
+    int windowBits = 15;  // 15 to enable any window size
+    windowBits += 32;     // and +32 to enable zlib or gzip header detection.
+    if (inflateInit2(&_stream, windowBits) != Z_OK) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  inflateEnd(&_stream);
+}
+
+- (NSUInteger)windowSize {
+  return _output.windowSize;
+}
+
+- (uint64_t)totalBytesIn {
+  return _completedMembersBytesIn + _stream.total_in;
+}
+
+- (uint64_t)totalBytesOut {
+  return _output.totalBytesOut;
+}
+
+/// Prepares the stream for the next concatenated member without losing the input count.
+- (void)resetForNextMember {
+  _completedMembersBytesIn += _stream.total_in;
+  inflateReset(&_stream);
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+  return [self appendBytes:data.bytes length:data.length error:error];
+}
+
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError **)error {
+  if (_finished) {
+    if (error) {
+      *error = GULGzipFinishedError();
+    }
+    return NO;
+  }
+
+  const unsigned char *input = bytes;
+  while (length > 0) {
+    if (_atMemberBoundary) {
+      // More input after a complete member is the start of a concatenated member.
+      [self resetForNextMember];
+      _atMemberBoundary = NO;
+    }
+
+    uInt inputWindow = (uInt)MIN(length, (NSUInteger)UINT_MAX);
+    _stream.next_in = (Bytef *)input;
+    _stream.avail_in = inputWindow;
+
+    for (;;) {
+      _stream.next_out = _output.window;
+      _stream.avail_out = (uInt)_output.windowSize;
+      int retCode = inflate(&_stream, Z_NO_FLUSH);
+      if (retCode == Z_NEED_DICT) {
+        retCode = Z_DATA_ERROR;
+      }
+      if (retCode != Z_OK && retCode != Z_STREAM_END && retCode != Z_BUF_ERROR) {
+        if (error) {
+          *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, &_stream);
+        }
+        return NO;
+      }
+      if (![_output emitWindowBytes:_output.windowSize - _stream.avail_out error:error]) {
+        return NO;
+      }
+      if (retCode == Z_STREAM_END) {
+        if (_stream.avail_in == 0) {
+          _atMemberBoundary = YES;
+          break;
+        }
+        [self resetForNextMember];
+        continue;
+      }
+      if (_stream.avail_out != 0) {
+        // All of the input window was consumed.
+        break;
+      }
+    }
+
+    input += inputWindow;
+    length -= inputWindow;
+  }
+  return YES;
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+  if (_finished) {
+    if (error) {
+      *error = GULGzipFinishedError();
+    }
+    return NO;
+  }
+  _finished = YES;
+  if (!_atMemberBoundary) {
+    if (error) {
+      *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
+                                   code:GULNSDataZlibErrorIncompleteStream
+                               userInfo:nil];
+    }
+    return NO;
+  }
+  return YES;
+}
+
+@end
@@ -16,92 +16,287 @@
 
 #import <zlib.h>
 
-#define kChunkSize 1024
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibBackend.h"
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibInternal.h"
+#import "GoogleUtilities/NSData+zlib/GULZlibStreamPool.h"
+
+/// The smallest output buffer an inflate starts with or grows by.
+static const NSUInteger kGULNSDataZlibMinimumOutputCapacity = 1024;
+
 #define Z_DEFAULT_COMPRESSION (-1)
 
 NSString *const GULNSDataZlibErrorDomain = @"com.google.GULNSDataZlibErrorDomain";
 NSString *const GULNSDataZlibErrorKey = @"GULNSDataZlibErrorKey";
 NSString *const GULNSDataZlibRemainingBytesKey = @"GULNSDataZlibRemainingBytesKey";
 
-@implementation NSData (GULGzip)
+void GULNSDataZlibWriteGzipHeader(unsigned char *header) {
+  static const unsigned char kHeader[] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 3};
+  memcpy(header, kHeader, kGULNSDataZlibGzipHeaderLength);
+}
 
-+ (nullable NSData *)gul_dataByInflatingGzippedData:(NSData *)data error:(NSError **)error {
+void GULNSDataZlibWriteGzipTrailer(unsigned char *trailer, uLong crc, unsigned long long length) {
+  // The CRC-32 and the length modulo 2^32, both little-endian.
+  for (int i = 0; i < 4; i++) {
+    trailer[i] = (unsigned char)(crc >> (8 * i));
+    trailer[4 + i] = (unsigned char)(length >> (8 * i));
+  }
+}
+
+uLong GULNSDataZlibCRC32(const unsigned char *bytes, NSUInteger length) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  while (length > 0) {
+    uInt window = (uInt)MIN(length, (NSUInteger)UINT_MAX);
+    crc = crc32(crc, bytes, window);
+    bytes += window;
+    length -= window;
+  }
+  return crc;
+}
+
+NSError *GULNSDataZlibErrorWithStream(NSInteger code, int zlibCode, const z_stream *stream) {
+  NSMutableDictionary *userInfo =
+      [NSMutableDictionary dictionaryWithObject:[NSNumber numberWithInt:zlibCode]
+                                         forKey:GULNSDataZlibErrorKey];
+  if (stream && stream->msg) {
+    NSString *message = [NSString stringWithUTF8String:stream->msg];
+    if (message) {
+      [userInfo setObject:message forKey:NSLocalizedDescriptionKey];
+    }
+  }
+  return [NSError errorWithDomain:GULNSDataZlibErrorDomain code:code userInfo:userInfo];
+}
+
+/// The largest slice of the input handed to zlib at once. `avail_in` is a 32-bit unsigned int, so
+/// 64-bit payloads are fed to the stream in windows of at most this size.
+static NSUInteger sGULNSDataZlibInputWindow = UINT_MAX;
+
+#ifdef DEBUG
+void GULNSDataZlibSetInputWindowForTesting(NSUInteger inputWindow) {
+  sGULNSDataZlibInputWindow = inputWindow ?: UINT_MAX;
+}
+#endif
+
+/// Moves the next window of the input into `strm` once zlib has consumed the current one.
+static void GULNSDataZlibFeedInput(z_stream *strm,
+                                   const unsigned char **nextInput,
+                                   NSUInteger *remainingInput) {
+  if (strm->avail_in != 0 || *remainingInput == 0) {
+    return;
+  }
+  uInt window = (uInt)MIN(*remainingInput, MIN(sGULNSDataZlibInputWindow, (NSUInteger)UINT_MAX));
+  strm->next_in = (Bytef *)*nextInput;
+  strm->avail_in = window;
+  *nextInput += window;
+  *remainingInput -= window;
+}
+
+/// The uncompressed size of each block compressed concurrently; the same default as pigz.
+static const NSUInteger kGULNSDataZlibDefaultParallelBlockSize = 128 * 1024;
+
+/// The size of the deflate window, which each concurrent block is primed with from the input before
+/// it so that matches can still reach back across block boundaries.
+static const NSUInteger kGULNSDataZlibDictionarySize = 32 * 1024;
+
+static NSUInteger sGULNSDataZlibParallelBlockSize = kGULNSDataZlibDefaultParallelBlockSize;
+
+#ifdef DEBUG
+void GULNSDataZlibSetParallelBlockSizeForTesting(NSUInteger blockSize) {
+  sGULNSDataZlibParallelBlockSize = blockSize ?: kGULNSDataZlibDefaultParallelBlockSize;
+}
+#endif
+
+/// One block of a concurrent gzip, compressed to raw deflate data.
+typedef struct {
+  unsigned char *bytes;
+  NSUInteger length;
+  uLong crc;
+  int zlibError;
+} GULNSDataZlibParallelBlock;
+
+/// Compresses the `length` bytes at `input + offset` into `block`. Blocks other than the last end
+/// with a sync flush, so they fall on a byte boundary and can be concatenated into one stream.
+static void GULNSDataZlibDeflateBlock(const unsigned char *input,
+                                      NSUInteger offset,
+                                      NSUInteger length,
+                                      BOOL last,
+                                      GULNSDataZlibParallelBlock *block) {
+  block->crc = crc32(crc32(0L, Z_NULL, 0), input + offset, (uInt)length);
+
+  GULZlibStreamPool *pool = [GULZlibStreamPool sharedPool];
+  int retCode = Z_OK;
+  // Negative window bits produce raw deflate data; the gzip framing is written by the caller.
+  z_stream *strm = [pool checkoutDeflateStreamWithLevel:Z_DEFAULT_COMPRESSION
+                                             windowBits:-15
+                                               memLevel:8
+                                               strategy:Z_DEFAULT_STRATEGY
+                                              zlibError:&retCode];
+  if (!strm) {
+    block->zlibError = retCode;
+    return;
+  }
+  if (offset > 0) {
+    NSUInteger dictionaryLength = MIN(offset, kGULNSDataZlibDictionarySize);
+    retCode =
+        deflateSetDictionary(strm, input + offset - dictionaryLength, (uInt)dictionaryLength);
+  }
+
+  // The sync flush marker adds a few bytes on top of deflateBound().
+  NSUInteger capacity = deflateBound(strm, length) + 16;
+  block->bytes = malloc(capacity);
+  if (!block->bytes) {
+    retCode = Z_MEM_ERROR;
+  }
+  strm->next_in = (Bytef *)input + offset;
+  strm->avail_in = (uInt)length;
+  int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+  while (retCode == Z_OK) {
+    if (block->length == capacity) {
+      unsigned char *grown = realloc(block->bytes, capacity * 2);
+      if (!grown) {
+        retCode = Z_MEM_ERROR;
+        break;
+      }
+      block->bytes = grown;
+      capacity *= 2;
+    }
+    uInt outputWindow = (uInt)(capacity - block->length);
+    strm->next_out = block->bytes + block->length;
+    strm->avail_out = outputWindow;
+    retCode = deflate(strm, flush);
+    block->length += outputWindow - strm->avail_out;
+    if (retCode == Z_OK && strm->avail_out != 0) {
+      // The sync flush completed.
+      break;
+    }
+  }
+  if (retCode == Z_STREAM_END || (retCode == Z_BUF_ERROR && !last)) {
+    retCode = Z_OK;
+  }
+  block->zlibError = retCode;
+  [pool checkinStream:strm];
+}
+
+NSUInteger GULNSDataZlibInflatedSizeHint(const unsigned char *bytes, NSUInteger length) {
+  // Hint the size at 4x the input size.
+  NSUInteger estimate = MAX(length * 4, kGULNSDataZlibMinimumOutputCapacity);
+  if (length >= 18 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+    const unsigned char *trailer = bytes + length - 4;
+    NSUInteger isize = (NSUInteger)trailer[0] | (NSUInteger)trailer[1] << 8 |
+                       (NSUInteger)trailer[2] << 16 | (NSUInteger)trailer[3] << 24;
+    if (isize > 0 && isize / kGULNSDataZlibMaximumDeflateRatio <= length) {
+      // ISIZE is the uncompressed size modulo 2^32, but it is not checked until the end, so a large
+      // one only sizes the output up to a bound and the rest is grown as inflate produces it.
+      return MIN(isize, MAX(estimate, (NSUInteger)kGULNSDataZlibMaximumTrustedInflatedSize));
+    }
+  }
+  return estimate;
+}
+
+/// Returns NO and sets `error` if `dictionary` is too long for zlib's 32-bit length. Longer
+/// dictionaries are otherwise passed through whole: zlib only keeps the last window's worth, but
+/// the dictionary id in zlib headers is the Adler-32 of all of it, so trimming here would break
+/// peers that set the same full dictionary.
+static BOOL GULNSDataZlibCheckDictionary(NSData *_Nullable dictionary, NSError **error) {
+  if (dictionary.length <= UINT_MAX) {
+    return YES;
+  }
+  if (error) {
+    *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, Z_STREAM_ERROR, NULL);
+  }
+  return NO;
+}
+
+/// Inflates `data` with a stream initialized with `windowBits`, using `dictionary` for raw streams
+/// or when a zlib stream asks for one.
+static NSData *_Nullable GULNSDataZlibInflate(NSData *data,
+                                              int windowBits,
+                                              NSData *_Nullable dictionary,
+                                              NSError **error) {
   const void *bytes = [data bytes];
   NSUInteger length = [data length];
   if (!bytes || !length) {
     return nil;
   }
 
-#if defined(__LP64__) && __LP64__
-  // Don't support > 32bit length for 64 bit, see note in header.
-  if (length > UINT_MAX) {
+  // Streams are recycled through the pool, so repeated calls skip zlib's setup and allocations.
+  if (!GULNSDataZlibCheckDictionary(dictionary, error)) {
     return nil;
   }
-#endif
-
-  z_stream strm;
-  bzero(&strm, sizeof(z_stream));
+  GULZlibStreamPool *pool = [GULZlibStreamPool sharedPool];
+  int retCode = Z_OK;
+  z_stream *strm = [pool checkoutInflateStreamWithWindowBits:windowBits zlibError:&retCode];
+  if (!strm) {
+    if (error) {
+      *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, NULL);
+    }
+    return nil;
+  }
+  if (dictionary.length && windowBits < 0) {
+    // Raw streams cannot ask for their dictionary, so it is set up front.
+    retCode = inflateSetDictionary(strm, dictionary.bytes, (uInt)dictionary.length);
+    if (retCode != Z_OK) {
+      if (error) {
+        *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, strm);
+      }
+      [pool checkinStream:strm];
+      return nil;
+    }
+  }
 
   // Setup the input.
-  strm.avail_in = (unsigned int)length;
-  strm.next_in = (unsigned char *)bytes;
-
-  int windowBits = 15;  // 15 to enable any window size
-  windowBits += 32;     // and +32 to enable zlib or gzip header detection.
+  const unsigned char *nextInput = bytes;
+  NSUInteger remainingInput = length;
 
-  int retCode;
-  if ((retCode = inflateInit2(&strm, windowBits)) != Z_OK) {
+  // Inflate straight into the result, which is grown only if the size hint was too small, e.g.
+  // for concatenated members, payloads over 4 GB whose ISIZE wrapped around, or an ISIZE beyond
+  // what is allocated up front.
+  NSMutableData *result =
+      [NSMutableData dataWithLength:GULNSDataZlibInflatedSizeHint(bytes, length)];
+  if (!result) {
     if (error) {
-      NSDictionary *userInfo = [NSDictionary dictionaryWithObject:[NSNumber numberWithInt:retCode]
-                                                           forKey:GULNSDataZlibErrorKey];
-      *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
-                                   code:GULNSDataZlibErrorInternal
-                               userInfo:userInfo];
+      *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, Z_MEM_ERROR, NULL);
     }
+    [pool checkinStream:strm];
     return nil;
   }
-
-  // Hint the size at 4x the input size.
-  NSMutableData *result = [NSMutableData dataWithCapacity:(length * 4)];
-  unsigned char output[kChunkSize];
+  NSUInteger produced = 0;
 
   // Loop to collect the data.
   do {
     // Update what we're passing in.
-    strm.avail_out = kChunkSize;
-    strm.next_out = output;
-    retCode = inflate(&strm, Z_NO_FLUSH);
+    GULNSDataZlibFeedInput(strm, &nextInput, &remainingInput);
+    if (produced == result.length) {
+      result.length = MAX(result.length * 2, kGULNSDataZlibMinimumOutputCapacity);
+    }
+    uInt outputWindow = (uInt)MIN(result.length - produced, (NSUInteger)UINT_MAX);
+    strm->next_out = (Bytef *)result.mutableBytes + produced;
+    strm->avail_out = outputWindow;
+    // Z_FINISH lets zlib skip its sliding window when the whole output fits in one call.
+    int flush = remainingInput > 0 ? Z_NO_FLUSH : Z_FINISH;
+    retCode = inflate(strm, flush);
+    produced += outputWindow - strm->avail_out;
+    if (retCode == Z_BUF_ERROR && strm->avail_out == 0) {
+      // Ran out of output space before the end of the stream; grow and keep going.
+      retCode = Z_OK;
+    } else if (retCode == Z_NEED_DICT && dictionary.length) {
+      retCode = inflateSetDictionary(strm, dictionary.bytes, (uInt)dictionary.length);
+    }
     if ((retCode != Z_OK) && (retCode != Z_STREAM_END)) {
       if (error) {
-        NSMutableDictionary *userInfo =
-            [NSMutableDictionary dictionaryWithObject:[NSNumber numberWithInt:retCode]
-                                               forKey:GULNSDataZlibErrorKey];
-        if (strm.msg) {
-          NSString *message = [NSString stringWithUTF8String:strm.msg];
-          if (message) {
-            [userInfo setObject:message forKey:NSLocalizedDescriptionKey];
-          }
-        }
-        *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
-                                     code:GULNSDataZlibErrorInternal
-                                 userInfo:userInfo];
+        *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, strm);
       }
-      inflateEnd(&strm);
+      [pool checkinStream:strm];
       return nil;
     }
-    // Collect what we got.
-    unsigned gotBack = kChunkSize - strm.avail_out;
-    if (gotBack > 0) {
-      [result appendBytes:output length:gotBack];
-    }
-
   } while (retCode == Z_OK);
+  result.length = produced;
 
   // Make sure there wasn't more data tacked onto the end of a valid compressed stream.
-  if (strm.avail_in != 0) {
+  if (strm->avail_in != 0 || remainingInput != 0) {
     if (error) {
+      unsigned long long remainingBytes = (unsigned long long)strm->avail_in + remainingInput;
       NSDictionary *userInfo =
-          [NSDictionary dictionaryWithObject:[NSNumber numberWithUnsignedInt:strm.avail_in]
+          [NSDictionary dictionaryWithObject:[NSNumber numberWithUnsignedLongLong:remainingBytes]
                                       forKey:GULNSDataZlibRemainingBytesKey];
       *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
                                    code:GULNSDataZlibErrorDataRemaining
@@ -110,98 +305,226 @@ NSString *const GULNSDataZlibRemainingBytesKey = @"GULNSDataZlibRemainingBytesKe
     result = nil;
   }
   // The only way out of the loop was by hitting the end of the stream.
-  NSAssert(retCode == Z_STREAM_END,
+  NSCAssert(retCode == Z_STREAM_END,
            @"Thought we finished inflate w/o getting a result of stream end, code %d", retCode);
 
   // Clean up.
-  inflateEnd(&strm);
+  [pool checkinStream:strm];
 
   return result;
 }
 
-+ (nullable NSData *)gul_dataByGzippingData:(NSData *)data error:(NSError **)error {
+/// Deflates `data` with a stream initialized with the given `deflateInit2` parameters, primed with
+/// `dictionary` if there is one.
+static NSData *_Nullable GULNSDataZlibDeflate(NSData *data,
+                                              int level,
+                                              int windowBits,
+                                              int strategy,
+                                              NSData *_Nullable dictionary,
+                                              NSError **error) {
   const void *bytes = [data bytes];
   NSUInteger length = [data length];
-
-  int level = Z_DEFAULT_COMPRESSION;
   if (!bytes || !length) {
     return nil;
   }
 
-#if defined(__LP64__) && __LP64__
-  // Don't support > 32bit length for 64 bit, see note in header.
-  if (length > UINT_MAX) {
-    if (error) {
-      *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
-                                   code:GULNSDataZlibErrorGreaterThan32BitsToCompress
-                               userInfo:nil];
-    }
+  int memLevel = 8;  // Default.
+
+  if (!GULNSDataZlibCheckDictionary(dictionary, error)) {
     return nil;
   }
-#endif
-
-  z_stream strm;
-  bzero(&strm, sizeof(z_stream));
-
-  int memLevel = 8;          // Default.
-  int windowBits = 15 + 16;  // Enable gzip header instead of zlib header.
-
-  int retCode;
-  if ((retCode = deflateInit2(&strm, level, Z_DEFLATED, windowBits, memLevel,
-                              Z_DEFAULT_STRATEGY)) != Z_OK) {
+  GULZlibStreamPool *pool = [GULZlibStreamPool sharedPool];
+  int retCode = Z_OK;
+  z_stream *strm = [pool checkoutDeflateStreamWithLevel:level
+                                             windowBits:windowBits
+                                               memLevel:memLevel
+                                               strategy:strategy
+                                              zlibError:&retCode];
+  if (!strm) {
     if (error) {
-      NSDictionary *userInfo = [NSDictionary dictionaryWithObject:[NSNumber numberWithInt:retCode]
-                                                           forKey:GULNSDataZlibErrorKey];
-      *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
-                                   code:GULNSDataZlibErrorInternal
-                               userInfo:userInfo];
+      *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, NULL);
     }
     return nil;
   }
+  if (dictionary.length) {
+    // Fails for gzip framing, which cannot signal a dictionary.
+    retCode = deflateSetDictionary(strm, dictionary.bytes, (uInt)dictionary.length);
+    if (retCode != Z_OK) {
+      if (error) {
+        *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, strm);
+      }
+      [pool checkinStream:strm];
+      return nil;
+    }
+  }
 
-  // Hint the size at 1/4 the input size.
-  NSMutableData *result = [NSMutableData dataWithCapacity:(length / 4)];
-  unsigned char output[kChunkSize];
+  // deflateBound() is an upper bound on the output, so deflate writes in place without growing.
+  NSMutableData *result = [NSMutableData dataWithLength:deflateBound(strm, length)];
+  NSUInteger produced = 0;
 
   // Setup the input.
-  strm.avail_in = (unsigned int)length;
-  strm.next_in = (unsigned char *)bytes;
+  const unsigned char *nextInput = bytes;
+  NSUInteger remainingInput = length;
 
   // Collect the data.
   do {
     // update what we're passing in
-    strm.avail_out = kChunkSize;
-    strm.next_out = output;
-    retCode = deflate(&strm, Z_FINISH);
+    GULNSDataZlibFeedInput(strm, &nextInput, &remainingInput);
+    // Only finish the stream once the last window of the input has been handed to zlib.
+    int flush = remainingInput > 0 ? Z_NO_FLUSH : Z_FINISH;
+    if (produced == result.length) {
+      // Defensive; the bound only strictly holds for a single Z_FINISH call.
+      result.length += MAX(result.length / 8, kGULNSDataZlibMinimumOutputCapacity);
+    }
+    uInt outputWindow = (uInt)MIN(result.length - produced, (NSUInteger)UINT_MAX);
+    strm->next_out = (Bytef *)result.mutableBytes + produced;
+    strm->avail_out = outputWindow;
+    retCode = deflate(strm, flush);
     if ((retCode != Z_OK) && (retCode != Z_STREAM_END)) {
       if (error) {
-        NSDictionary *userInfo = [NSDictionary dictionaryWithObject:[NSNumber numberWithInt:retCode]
-                                                             forKey:GULNSDataZlibErrorKey];
-        *error = [NSError errorWithDomain:GULNSDataZlibErrorDomain
-                                     code:GULNSDataZlibErrorInternal
-                                 userInfo:userInfo];
+        *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, strm);
       }
-      deflateEnd(&strm);
+      [pool checkinStream:strm];
       return nil;
     }
-    // Collect what we got.
-    unsigned gotBack = kChunkSize - strm.avail_out;
-    if (gotBack > 0) {
-      [result appendBytes:output length:gotBack];
-    }
-
+    produced += outputWindow - strm->avail_out;
   } while (retCode == Z_OK);
+  result.length = produced;
 
   // If the loop exits, it used all input and the stream ended.
-  NSAssert(strm.avail_in == 0,
-           @"Should have finished deflating without using all input, %u bytes left", strm.avail_in);
-  NSAssert(retCode == Z_STREAM_END,
-           @"thought we finished deflate w/o getting a result of stream end, code %d", retCode);
+  NSCAssert(strm->avail_in == 0 && remainingInput == 0,
+            @"Should have finished deflating without using all input, %llu bytes left",
+            (unsigned long long)strm->avail_in + remainingInput);
+  NSCAssert(retCode == Z_STREAM_END,
+            @"thought we finished deflate w/o getting a result of stream end, code %d", retCode);
 
   // Clean up.
-  deflateEnd(&strm);
+  [pool checkinStream:strm];
 
   return result;
 }
 
+/// Returns the `windowBits` for `format`, as passed to `deflateInit2`.
+static int GULNSDataZlibDeflateWindowBits(GULNSDataZlibFormat format) {
+  switch (format) {
+    case GULNSDataZlibFormatZlib:
+      return 15;
+    case GULNSDataZlibFormatRaw:
+      return -15;
+    case GULNSDataZlibFormatGzip:
+    default:
+      return 15 + 16;  // Enable gzip header instead of zlib header.
+  }
+}
+
+static NSData *_Nullable GULNSDataZlibBackendZlibGzip(NSData *data, NSError **error) {
+  return GULNSDataZlibDeflate(data, Z_DEFAULT_COMPRESSION, 15 + 16, Z_DEFAULT_STRATEGY, nil, error);
+}
+
+static NSData *_Nullable GULNSDataZlibBackendZlibInflate(NSData *data, NSError **error) {
+  int windowBits = 15;  // 15 to enable any window size
+  windowBits += 32;     // and +32 to enable zlib or gzip header detection.
+  return GULNSDataZlibInflate(data, windowBits, nil, error);
+}
+
+const GULNSDataZlibBackend GULNSDataZlibBackendZlib = {
+    .name = "zlib",
+    .gzip = GULNSDataZlibBackendZlibGzip,
+    .inflate = GULNSDataZlibBackendZlibInflate,
+};
+
+const GULNSDataZlibBackend *GULNSDataZlibDefaultBackend(void) {
+#if GUL_NSDATA_ZLIB_USE_COMPRESSION_FRAMEWORK
+  return &GULNSDataZlibBackendCompression;
+#else
+  return &GULNSDataZlibBackendZlib;
+#endif
+}
+
+@implementation NSData (GULGzip)
+
++ (nullable NSData *)gul_dataByInflatingGzippedData:(NSData *)data error:(NSError **)error {
+  return GULNSDataZlibDefaultBackend()->inflate(data, error);
+}
+
++ (nullable NSData *)gul_dataByGzippingData:(NSData *)data error:(NSError **)error {
+  return GULNSDataZlibDefaultBackend()->gzip(data, error);
+}
+
++ (nullable NSData *)gul_dataByDeflatingData:(NSData *)data
+                                     options:(GULNSDataZlibOptions *)options
+                                       error:(NSError **)error {
+  int windowBits = GULNSDataZlibDeflateWindowBits(options.format);
+  return GULNSDataZlibDeflate(data, (int)options.level, windowBits, (int)options.strategy,
+                              options.dictionary, error);
+}
+
++ (nullable NSData *)gul_dataByInflatingData:(NSData *)data
+                                     options:(GULNSDataZlibOptions *)options
+                                       error:(NSError **)error {
+  int windowBits = GULNSDataZlibDeflateWindowBits(options.format);
+  if (options.format == GULNSDataZlibFormatGzip) {
+    windowBits = 15 + 32;  // Accept both gzip and zlib headers.
+  }
+  return GULNSDataZlibInflate(data, windowBits, options.dictionary, error);
+}
+
++ (nullable NSData *)gul_dataByGzippingData:(NSData *)data
+                       concurrencyThreshold:(NSUInteger)concurrencyThreshold
+                                      error:(NSError **)error {
+  NSUInteger length = [data length];
+  NSUInteger blockSize = MIN(sGULNSDataZlibParallelBlockSize, (NSUInteger)UINT_MAX);
+  if (length <= concurrencyThreshold || length <= blockSize) {
+    return [self gul_dataByGzippingData:data error:error];
+  }
+
+  // Like pigz, compress fixed-size blocks concurrently and stitch them into a single gzip member.
+  const unsigned char *bytes = [data bytes];
+  NSUInteger blockCount = (length + blockSize - 1) / blockSize;
+  GULNSDataZlibParallelBlock *blocks = calloc(blockCount, sizeof(GULNSDataZlibParallelBlock));
+  if (!blocks) {
+    if (error) {
+      *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, Z_MEM_ERROR, NULL);
+    }
+    return nil;
+  }
+  dispatch_apply(blockCount, DISPATCH_APPLY_AUTO, ^(size_t i) {
+    NSUInteger offset = i * blockSize;
+    GULNSDataZlibDeflateBlock(bytes, offset, MIN(blockSize, length - offset), i == blockCount - 1,
+                              &blocks[i]);
+  });
+
+  int retCode = Z_OK;
+  NSUInteger compressedLength = kGULNSDataZlibGzipHeaderLength + kGULNSDataZlibGzipTrailerLength;
+  uLong crc = crc32(0L, Z_NULL, 0);
+  for (NSUInteger i = 0; i < blockCount && retCode == Z_OK; i++) {
+    retCode = blocks[i].zlibError;
+    compressedLength += blocks[i].length;
+    NSUInteger offset = i * blockSize;
+    crc = crc32_combine(crc, blocks[i].crc, (z_off_t)MIN(blockSize, length - offset));
+  }
+
+  NSMutableData *result = nil;
+  if (retCode == Z_OK) {
+    result = [NSMutableData dataWithCapacity:compressedLength];
+    unsigned char header[kGULNSDataZlibGzipHeaderLength];
+    GULNSDataZlibWriteGzipHeader(header);
+    [result appendBytes:header length:sizeof(header)];
+    for (NSUInteger i = 0; i < blockCount; i++) {
+      [result appendBytes:blocks[i].bytes length:blocks[i].length];
+    }
+    unsigned char trailer[kGULNSDataZlibGzipTrailerLength];
+    GULNSDataZlibWriteGzipTrailer(trailer, crc, length);
+    [result appendBytes:trailer length:sizeof(trailer)];
+  } else if (error) {
+    *error = GULNSDataZlibErrorWithStream(GULNSDataZlibErrorInternal, retCode, NULL);
+  }
+
+  for (NSUInteger i = 0; i < blockCount; i++) {
+    free(blocks[i].bytes);
+  }
+  free(blocks);
+  return result;
+}
+
 @end
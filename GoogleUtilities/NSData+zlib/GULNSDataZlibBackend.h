@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/// Set to 1 to have `NSData (GULGzip)` compress and inflate whole buffers with the Compression
+/// framework instead of zlib's streaming API. The output is still standard gzip, but not
+/// byte-for-byte the same as zlib's.
+#ifndef GUL_NSDATA_ZLIB_USE_COMPRESSION_FRAMEWORK
+#define GUL_NSDATA_ZLIB_USE_COMPRESSION_FRAMEWORK 0
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A one-shot implementation of `gul_dataByGzippingData:error:` and
+/// `gul_dataByInflatingGzippedData:error:`. Both functions follow the contracts of those methods.
+typedef struct {
+  /// A short name for logs and benchmarks.
+  const char *name;
+
+  /// Returns `data` compressed into a single gzip member at the default level.
+  NSData *_Nullable (*gzip)(NSData *data, NSError **error);
+
+  /// Returns the payload of the gzip or zlib data in `data`.
+  NSData *_Nullable (*inflate)(NSData *data, NSError **error);
+} GULNSDataZlibBackend;
+
+/// zlib's streaming API. Handles every input and produces the reference output.
+FOUNDATION_EXPORT const GULNSDataZlibBackend GULNSDataZlibBackendZlib;
+
+/// The Compression framework's raw deflate codec with gzip framing written around it. Inputs it
+/// does not handle, such as zlib framing, concatenated members or optional gzip header fields,
+/// as well as any failures, fall back to `GULNSDataZlibBackendZlib`.
+FOUNDATION_EXPORT const GULNSDataZlibBackend GULNSDataZlibBackendCompression;
+
+/// The backend selected at build time with `GUL_NSDATA_ZLIB_USE_COMPRESSION_FRAMEWORK`.
+FOUNDATION_EXPORT const GULNSDataZlibBackend *GULNSDataZlibDefaultBackend(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,108 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibBackend.h"
+
+#import <compression.h>
+#import <zlib.h>
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibInternal.h"
+
+static NSData *_Nullable GULNSDataZlibBackendCompressionGzip(NSData *data, NSError **error) {
+  const unsigned char *bytes = [data bytes];
+  NSUInteger length = [data length];
+  if (!bytes || !length) {
+    return nil;
+  }
+
+  // COMPRESSION_ZLIB produces raw deflate data, which falls back to stored blocks when it does not
+  // shrink, so zlib's bound holds for it as well.
+  NSUInteger capacity = compressBound(length);
+  NSMutableData *result = [NSMutableData
+      dataWithLength:kGULNSDataZlibGzipHeaderLength + capacity + kGULNSDataZlibGzipTrailerLength];
+  if (!result) {
+    return GULNSDataZlibBackendZlib.gzip(data, error);
+  }
+  unsigned char *output = result.mutableBytes;
+  size_t produced = compression_encode_buffer(output + kGULNSDataZlibGzipHeaderLength, capacity,
+                                              bytes, length, NULL, COMPRESSION_ZLIB);
+  if (produced == 0) {
+    return GULNSDataZlibBackendZlib.gzip(data, error);
+  }
+
+  GULNSDataZlibWriteGzipHeader(output);
+  GULNSDataZlibWriteGzipTrailer(output + kGULNSDataZlibGzipHeaderLength + produced,
+                                GULNSDataZlibCRC32(bytes, length), length);
+  result.length = kGULNSDataZlibGzipHeaderLength + produced + kGULNSDataZlibGzipTrailerLength;
+  return result;
+}
+
+static NSData *_Nullable GULNSDataZlibBackendCompressionInflate(NSData *data, NSError **error) {
+  const unsigned char *bytes = [data bytes];
+  NSUInteger length = [data length];
+
+  // Only a single gzip member with a bare header is decoded here, into an output sized by ISIZE.
+  // Anything else, e.g. concatenated members, truncation or payloads over 4 GB, fails one of the
+  // checks below and is left to zlib, which also reports the errors.
+  if (length < kGULNSDataZlibGzipHeaderLength + kGULNSDataZlibGzipTrailerLength ||
+      bytes[0] != 0x1f || bytes[1] != 0x8b || bytes[2] != Z_DEFLATED || bytes[3] != 0) {
+    return GULNSDataZlibBackendZlib.inflate(data, error);
+  }
+  const unsigned char *trailer = bytes + length - kGULNSDataZlibGzipTrailerLength;
+  uLong expectedCRC = (uLong)trailer[0] | (uLong)trailer[1] << 8 | (uLong)trailer[2] << 16 |
+                      (uLong)trailer[3] << 24;
+  NSUInteger isize = (NSUInteger)trailer[4] | (NSUInteger)trailer[5] << 8 |
+                     (NSUInteger)trailer[6] << 16 | (NSUInteger)trailer[7] << 24;
+  if (isize == 0 || isize / kGULNSDataZlibMaximumDeflateRatio > length) {
+    return GULNSDataZlibBackendZlib.inflate(data, error);
+  }
+
+  // The trailer is only verified at the end, so the output starts at a bounded size and is grown
+  // toward ISIZE as the decoder fills it.
+  NSMutableData *result =
+      [NSMutableData dataWithLength:GULNSDataZlibInflatedSizeHint(bytes, length)];
+  compression_stream stream;
+  if (!result ||
+      compression_stream_init(&stream, COMPRESSION_STREAM_DECODE, COMPRESSION_ZLIB) !=
+          COMPRESSION_STATUS_OK) {
+    return GULNSDataZlibBackendZlib.inflate(data, error);
+  }
+  stream.src_ptr = bytes + kGULNSDataZlibGzipHeaderLength;
+  stream.src_size = length - kGULNSDataZlibGzipHeaderLength - kGULNSDataZlibGzipTrailerLength;
+  stream.dst_ptr = result.mutableBytes;
+  stream.dst_size = result.length;
+  compression_status status;
+  while ((status = compression_stream_process(&stream, COMPRESSION_STREAM_FINALIZE)) ==
+             COMPRESSION_STATUS_OK &&
+         stream.dst_size == 0 && result.length < isize) {
+    NSUInteger produced = result.length;
+    result.length = MIN(produced * 2, isize);
+    stream.dst_ptr = (uint8_t *)result.mutableBytes + produced;
+    stream.dst_size = result.length - produced;
+  }
+  // The deflate data must end exactly at the trailer and fill the output exactly.
+  BOOL valid = status == COMPRESSION_STATUS_END && stream.src_size == 0 && stream.dst_size == 0 &&
+               result.length == isize;
+  compression_stream_destroy(&stream);
+  if (!valid || GULNSDataZlibCRC32(result.bytes, isize) != expectedCRC) {
+    return GULNSDataZlibBackendZlib.inflate(data, error);
+  }
+  return result;
+}
+
+const GULNSDataZlibBackend GULNSDataZlibBackendCompression = {
+    .name = "Compression",
+    .gzip = GULNSDataZlibBackendCompressionGzip,
+    .inflate = GULNSDataZlibBackendCompressionInflate,
+};
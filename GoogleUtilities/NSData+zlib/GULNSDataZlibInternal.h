@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <zlib.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns an error in `GULNSDataZlibErrorDomain` with the given code. `zlibCode` is stored under
+/// `GULNSDataZlibErrorKey` and `stream->msg`, if any, under `NSLocalizedDescriptionKey`.
+FOUNDATION_EXPORT NSError *GULNSDataZlibErrorWithStream(NSInteger code,
+                                                        int zlibCode,
+                                                        const z_stream *_Nullable stream);
+
+enum {
+  /// The length of the gzip member header written by `GULNSDataZlibWriteGzipHeader`.
+  kGULNSDataZlibGzipHeaderLength = 10,
+
+  /// The length of a gzip member trailer.
+  kGULNSDataZlibGzipTrailerLength = 8,
+
+  /// The maximum ratio deflate can achieve, used to reject implausible gzip ISIZE trailers.
+  kGULNSDataZlibMaximumDeflateRatio = 1032,
+
+  /// The most output allocated up front on the word of an ISIZE trailer, unless the input is
+  /// large enough to hint more anyway. Larger outputs are grown as inflate produces them.
+  kGULNSDataZlibMaximumTrustedInflatedSize = 64 * 1024 * 1024,
+};
+
+/// Returns the output capacity to allocate before inflating the `length` bytes at `bytes`. For a
+/// gzip member this is its ISIZE trailer, capped at `kGULNSDataZlibMaximumTrustedInflatedSize` or
+/// 4x the input, whichever is larger, since the trailer is not verified until the end.
+FOUNDATION_EXPORT NSUInteger GULNSDataZlibInflatedSizeHint(const unsigned char *bytes,
+                                                           NSUInteger length);
+
+/// Writes a gzip member header without a name or modification time, as zlib writes it on Unix.
+FOUNDATION_EXPORT void GULNSDataZlibWriteGzipHeader(unsigned char *header);
+
+/// Writes the gzip member trailer for `length` bytes of input whose CRC-32 is `crc`.
+FOUNDATION_EXPORT void GULNSDataZlibWriteGzipTrailer(unsigned char *trailer,
+                                                     uLong crc,
+                                                     unsigned long long length);
+
+/// Returns the CRC-32 of the `length` bytes at `bytes`, fed to zlib in 32-bit windows.
+FOUNDATION_EXPORT uLong GULNSDataZlibCRC32(const unsigned char *bytes, NSUInteger length);
+
+#ifdef DEBUG
+/// Limits each slice of the input handed to zlib to `inputWindow` bytes, so that tests can take the
+/// refill path of payloads larger than 4 GB with small ones. 0 restores the default.
+FOUNDATION_EXPORT void GULNSDataZlibSetInputWindowForTesting(NSUInteger inputWindow);
+
+/// Overrides the uncompressed size of each block compressed concurrently. 0 restores the default.
+FOUNDATION_EXPORT void GULNSDataZlibSetParallelBlockSizeForTesting(NSUInteger blockSize);
+#endif
+
+NS_ASSUME_NONNULL_END
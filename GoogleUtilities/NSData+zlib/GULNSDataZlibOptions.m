@@ -0,0 +1,40 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSDataZlibOptions.h"
+
+const NSInteger GULNSDataZlibDefaultCompressionLevel = -1;
+
+@implementation GULNSDataZlibOptions
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _level = GULNSDataZlibDefaultCompressionLevel;
+    _strategy = GULNSDataZlibStrategyDefault;
+    _format = GULNSDataZlibFormatGzip;
+  }
+  return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  GULNSDataZlibOptions *copy = [[[self class] allocWithZone:zone] init];
+  copy.level = self.level;
+  copy.strategy = self.strategy;
+  copy.format = self.format;
+  copy.dictionary = self.dictionary;
+  return copy;
+}
+
+@end
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <zlib.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A thread-safe, bounded pool of initialized zlib streams.
+///
+/// Initializing a deflate stream allocates roughly 256 KB of state with the default memLevel, which
+/// dominates the cost of compressing small payloads. Streams checked back in are recycled with
+/// `deflateReset`/`inflateReset` so the next checkout with the same parameters skips that setup.
+/// Idle streams are released when the system reports memory pressure.
+@interface GULZlibStreamPool : NSObject
+
+/// The pool used by `NSData (GULGzip)`. It keeps up to one idle stream per active processor.
++ (instancetype)sharedPool;
+
+/// Initializes a pool that keeps at most `maximumIdleStreams` streams around between uses.
+- (instancetype)initWithMaximumIdleStreams:(NSUInteger)maximumIdleStreams
+    NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The maximum number of streams kept around between uses.
+@property(nonatomic, readonly) NSUInteger maximumIdleStreams;
+
+/// The number of streams currently waiting to be reused.
+@property(nonatomic, readonly) NSUInteger idleStreamCount;
+
+/// Returns a deflate stream initialized with the given `deflateInit2` parameters, reusing an idle
+/// one if possible. Returns NULL and sets `zlibError` if initialization failed.
+- (nullable z_stream *)checkoutDeflateStreamWithLevel:(int)level
+                                           windowBits:(int)windowBits
+                                             memLevel:(int)memLevel
+                                             strategy:(int)strategy
+                                            zlibError:(int *)zlibError;
+
+/// Returns an inflate stream initialized with the given `inflateInit2` window bits, reusing an idle
+/// one if possible. Returns NULL and sets `zlibError` if initialization failed.
+- (nullable z_stream *)checkoutInflateStreamWithWindowBits:(int)windowBits
+                                                 zlibError:(int *)zlibError;
+
+/// Resets `stream` and keeps it for reuse, or ends it if the pool is full. The stream must have
+/// been checked out of this pool and must not be used afterwards.
+- (void)checkinStream:(z_stream *)stream;
+
+/// Ends all idle streams.
+- (void)trim;
+
+@end
+
+NS_ASSUME_NONNULL_END
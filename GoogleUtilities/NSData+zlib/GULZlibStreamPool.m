@@ -0,0 +1,236 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/NSData+zlib/GULZlibStreamPool.h"
+
+#import <os/lock.h>
+
+/// The smallest number of idle streams kept by the shared pool. Enough for a few concurrent uploads
+/// on devices with few cores.
+static const NSUInteger kGULZlibSharedPoolMinimumIdleStreams = 4;
+
+/// A z_stream together with the parameters it was initialized with.
+typedef struct {
+  /// Must be the first member so that a checked out `z_stream *` can be cast back.
+  z_stream stream;
+  BOOL deflating;
+  int level;
+  int windowBits;
+  int memLevel;
+  int strategy;
+} GULZlibPooledStream;
+
+static void GULZlibPooledStreamEnd(GULZlibPooledStream *pooledStream) {
+  if (pooledStream->deflating) {
+    deflateEnd(&pooledStream->stream);
+  } else {
+    inflateEnd(&pooledStream->stream);
+  }
+  free(pooledStream);
+}
+
+@implementation GULZlibStreamPool {
+  /// Guards `_idleStreams` and `_idleStreamCount`.
+  os_unfair_lock _lock;
+
+  /// Streams waiting to be reused; only the first `_idleStreamCount` entries are valid.
+  GULZlibPooledStream **_idleStreams;
+
+  NSUInteger _idleStreamCount;
+
+  /// Trims the pool when the system is low on memory.
+  dispatch_source_t _memoryPressureSource;
+}
+
++ (instancetype)sharedPool {
+  static GULZlibStreamPool *sharedPool;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    // Concurrent gzip compresses one block per active core at a time, so keep a stream for each of
+    // them. The idle footprint is about 256 KB of deflate state per stream.
+    NSUInteger maximumIdleStreams = MAX(kGULZlibSharedPoolMinimumIdleStreams,
+                                        [NSProcessInfo processInfo].activeProcessorCount);
+    sharedPool = [[GULZlibStreamPool alloc] initWithMaximumIdleStreams:maximumIdleStreams];
+  });
+  return sharedPool;
+}
+
+- (instancetype)initWithMaximumIdleStreams:(NSUInteger)maximumIdleStreams {
+  self = [super init];
+  if (self) {
+    _lock = OS_UNFAIR_LOCK_INIT;
+    _maximumIdleStreams = maximumIdleStreams;
+    _idleStreams = calloc(MAX(maximumIdleStreams, 1), sizeof(GULZlibPooledStream *));
+    if (!_idleStreams) {
+      return nil;
+    }
+
+    _memoryPressureSource = dispatch_source_create(
+        DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+        DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+        dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+    __weak GULZlibStreamPool *weakSelf = self;
+    dispatch_source_set_event_handler(_memoryPressureSource, ^{
+      [weakSelf trim];
+    });
+    dispatch_resume(_memoryPressureSource);
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_memoryPressureSource) {
+    dispatch_source_cancel(_memoryPressureSource);
+  }
+  [self trim];
+  free(_idleStreams);
+}
+
+- (NSUInteger)idleStreamCount {
+  os_unfair_lock_lock(&_lock);
+  NSUInteger count = _idleStreamCount;
+  os_unfair_lock_unlock(&_lock);
+  return count;
+}
+
+- (z_stream *)checkoutDeflateStreamWithLevel:(int)level
+                                  windowBits:(int)windowBits
+                                    memLevel:(int)memLevel
+                                    strategy:(int)strategy
+                                   zlibError:(int *)zlibError {
+  GULZlibPooledStream *pooledStream =
+      [self takeIdleStreamDeflating:YES
+                              level:level
+                         windowBits:windowBits
+                           memLevel:memLevel
+                           strategy:strategy];
+  if (pooledStream) {
+    return &pooledStream->stream;
+  }
+
+  pooledStream = calloc(1, sizeof(GULZlibPooledStream));
+  if (!pooledStream) {
+    *zlibError = Z_MEM_ERROR;
+    return NULL;
+  }
+  pooledStream->deflating = YES;
+  pooledStream->level = level;
+  pooledStream->windowBits = windowBits;
+  pooledStream->memLevel = memLevel;
+  pooledStream->strategy = strategy;
+  int retCode =
+      deflateInit2(&pooledStream->stream, level, Z_DEFLATED, windowBits, memLevel, strategy);
+  if (retCode != Z_OK) {
+    free(pooledStream);
+    *zlibError = retCode;
+    return NULL;
+  }
+  return &pooledStream->stream;
+}
+
+- (z_stream *)checkoutInflateStreamWithWindowBits:(int)windowBits zlibError:(int *)zlibError {
+  GULZlibPooledStream *pooledStream = [self takeIdleStreamDeflating:NO
+                                                              level:0
+                                                         windowBits:windowBits
+                                                           memLevel:0
+                                                           strategy:0];
+  if (pooledStream) {
+    return &pooledStream->stream;
+  }
+
+  pooledStream = calloc(1, sizeof(GULZlibPooledStream));
+  if (!pooledStream) {
+    *zlibError = Z_MEM_ERROR;
+    return NULL;
+  }
+  pooledStream->windowBits = windowBits;
+  int retCode = inflateInit2(&pooledStream->stream, windowBits);
+  if (retCode != Z_OK) {
+    free(pooledStream);
+    *zlibError = retCode;
+    return NULL;
+  }
+  return &pooledStream->stream;
+}
+
+- (void)checkinStream:(z_stream *)stream {
+  GULZlibPooledStream *pooledStream = (GULZlibPooledStream *)stream;
+  // Reset outside of the lock; it also recovers streams that stopped on an error.
+  int retCode = pooledStream->deflating ? deflateReset(stream) : inflateReset(stream);
+  stream->next_in = Z_NULL;
+  stream->avail_in = 0;
+  stream->next_out = Z_NULL;
+  stream->avail_out = 0;
+
+  if (retCode == Z_OK) {
+    os_unfair_lock_lock(&_lock);
+    if (_idleStreamCount < _maximumIdleStreams) {
+      _idleStreams[_idleStreamCount++] = pooledStream;
+      pooledStream = NULL;
+    }
+    os_unfair_lock_unlock(&_lock);
+  }
+
+  if (pooledStream) {
+    GULZlibPooledStreamEnd(pooledStream);
+  }
+}
+
+- (void)trim {
+  // Take the idle streams under the lock but end them after unlocking, so checkouts on other
+  // threads do not wait for zlib to free its state.
+  GULZlibPooledStream **trimmedStreams =
+      calloc(MAX(_maximumIdleStreams, 1), sizeof(GULZlibPooledStream *));
+  if (!trimmedStreams) {
+    return;
+  }
+  os_unfair_lock_lock(&_lock);
+  NSUInteger trimmedCount = _idleStreamCount;
+  memcpy(trimmedStreams, _idleStreams, trimmedCount * sizeof(GULZlibPooledStream *));
+  memset(_idleStreams, 0, trimmedCount * sizeof(GULZlibPooledStream *));
+  _idleStreamCount = 0;
+  os_unfair_lock_unlock(&_lock);
+
+  for (NSUInteger i = 0; i < trimmedCount; i++) {
+    GULZlibPooledStreamEnd(trimmedStreams[i]);
+  }
+  free(trimmedStreams);
+}
+
+#pragma mark - Private
+
+/// Removes and returns an idle stream initialized with the given parameters, if there is one.
+- (GULZlibPooledStream *)takeIdleStreamDeflating:(BOOL)deflating
+                                           level:(int)level
+                                      windowBits:(int)windowBits
+                                        memLevel:(int)memLevel
+                                        strategy:(int)strategy {
+  GULZlibPooledStream *match = NULL;
+  os_unfair_lock_lock(&_lock);
+  for (NSUInteger i = 0; i < _idleStreamCount; i++) {
+    GULZlibPooledStream *candidate = _idleStreams[i];
+    if (candidate->deflating == deflating && candidate->level == level &&
+        candidate->windowBits == windowBits && candidate->memLevel == memLevel &&
+        candidate->strategy == strategy) {
+      match = candidate;
+      _idleStreams[i] = _idleStreams[--_idleStreamCount];
+      _idleStreams[_idleStreamCount] = NULL;
+      break;
+    }
+  }
+  os_unfair_lock_unlock(&_lock);
+  return match;
+}
+
+@end
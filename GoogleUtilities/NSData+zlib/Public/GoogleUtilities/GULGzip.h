@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Receives a chunk of output from a `GULGzipEncoder` or `GULGzipDecoder`. Chunks are never larger
+/// than the window size of the encoder or decoder. Return NO to abort the stream, e.g. when the
+/// chunk could not be persisted; the pending call then fails with
+/// `GULNSDataZlibErrorOutputWriteFailed`.
+typedef BOOL (^GULGzipOutputHandler)(NSData *chunk);
+
+/// The default size of the output window, in bytes.
+FOUNDATION_EXPORT const NSUInteger GULGzipDefaultWindowSize;
+
+/// Incrementally gzips data that is pushed to it in chunks.
+///
+/// Only the zlib state and one output window are held in memory, so payloads that are built up
+/// piece by piece never have to be resident in full. Errors are reported in the
+/// `GULNSDataZlibErrorDomain` domain. This class is not thread safe.
+@interface GULGzipEncoder : NSObject
+
+/// The maximum size of a single output chunk.
+@property(nonatomic, readonly) NSUInteger windowSize;
+
+/// The number of uncompressed bytes consumed so far.
+@property(nonatomic, readonly) uint64_t totalBytesIn;
+
+/// The number of compressed bytes emitted so far.
+@property(nonatomic, readonly) uint64_t totalBytesOut;
+
+/// The CRC-32 of the uncompressed bytes consumed so far, as written to the gzip trailer.
+@property(nonatomic, readonly) uint32_t crc32;
+
+/// Gzips the file at `sourcePath` into the file descriptor `fileDescriptor` without reading it into
+/// memory. The source is mapped read-only and its pages are released as soon as they have been
+/// compressed; the output is written in `GULGzipDefaultWindowSize` chunks. The source must not be
+/// truncated while it is being compressed. The file descriptor is not closed.
+///
+/// On success, the number of bytes written and the CRC-32 of the source are returned through
+/// `compressedSize` and `crc`. Fails with `GULNSDataZlibErrorInputReadFailed` if the source cannot
+/// be opened or mapped.
++ (BOOL)gzipFileAtPath:(NSString *)sourcePath
+      toFileDescriptor:(int)fileDescriptor
+        compressedSize:(nullable uint64_t *)compressedSize
+                 crc32:(nullable uint32_t *)crc
+                 error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Initializes an encoder that passes compressed chunks of at most `windowSize` bytes to
+/// `outputHandler`. A `windowSize` of 0 selects `GULGzipDefaultWindowSize`.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler;
+
+/// Initializes an encoder that writes compressed output to `outputStream`. The stream must already
+/// be open and is not closed by the encoder.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                      outputStream:(NSOutputStream *)outputStream;
+
+/// Initializes an encoder that writes compressed output to the file descriptor `fileDescriptor`.
+/// The file descriptor is not closed by the encoder.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize fileDescriptor:(int)fileDescriptor;
+
+/// Compresses `data`, emitting any output that becomes available.
+- (BOOL)appendData:(NSData *)data error:(NSError **)error;
+
+/// Compresses `length` bytes starting at `bytes`, emitting any output that becomes available.
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError **)error;
+
+/// Flushes the remaining output and writes the gzip trailer. The encoder cannot be used after this
+/// call.
+- (BOOL)finishWithError:(NSError **)error;
+
+@end
+
+/// Incrementally inflates gzip or zlib data that is pushed to it in chunks.
+///
+/// Concatenated gzip members are decoded back to back, as `gunzip` does. Errors are reported in the
+/// `GULNSDataZlibErrorDomain` domain. This class is not thread safe.
+@interface GULGzipDecoder : NSObject
+
+/// The maximum size of a single output chunk.
+@property(nonatomic, readonly) NSUInteger windowSize;
+
+/// The number of compressed bytes consumed so far.
+@property(nonatomic, readonly) uint64_t totalBytesIn;
+
+/// The number of decompressed bytes emitted so far.
+@property(nonatomic, readonly) uint64_t totalBytesOut;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Initializes a decoder that passes inflated chunks of at most `windowSize` bytes to
+/// `outputHandler`. A `windowSize` of 0 selects `GULGzipDefaultWindowSize`.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                     outputHandler:(GULGzipOutputHandler)outputHandler;
+
+/// Initializes a decoder that writes inflated output to `outputStream`. The stream must already be
+/// open and is not closed by the decoder.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize
+                      outputStream:(NSOutputStream *)outputStream;
+
+/// Initializes a decoder that writes inflated output to the file descriptor `fileDescriptor`. The
+/// file descriptor is not closed by the decoder.
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize fileDescriptor:(int)fileDescriptor;
+
+/// Inflates `data`, emitting any output that becomes available.
+- (BOOL)appendData:(NSData *)data error:(NSError **)error;
+
+/// Inflates `length` bytes starting at `bytes`, emitting any output that becomes available.
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError **)error;
+
+/// Verifies that the compressed stream ended cleanly. Fails with
+/// `GULNSDataZlibErrorIncompleteStream` if the input stopped in the middle of a stream. The decoder
+/// cannot be used after this call.
+- (BOOL)finishWithError:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -14,13 +14,15 @@
 
 #import <Foundation/Foundation.h>
 
+#import "GULNSDataZlibOptions.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
 /// This is a copy of Google Toolbox for Mac library to avoid creating an extra framework.
 
-// NOTE: For 64bit, none of these apis handle input sizes >32bits, they will return nil when given
-// such data. To handle data of that size you really should be streaming it rather then doing it all
-// in memory.
+// NOTE: Inputs larger than 4 GB are fed to zlib in 32-bit windows, so memory-mapped payloads of any
+// size can be handled in one call. The whole result is still built in memory; to avoid that, stream
+// the data through GULGzipEncoder or GULGzipDecoder instead.
 
 @interface NSData (GULGzip)
 
@@ -32,11 +34,33 @@ NS_ASSUME_NONNULL_BEGIN
 /// compression level.
 + (nullable NSData *)gul_dataByGzippingData:(NSData *)data error:(NSError **)error;
 
+/// Returns the result of compressing the payload of |data| with the level, strategy, framing and
+/// preset dictionary in |options|. Fails with `GULNSDataZlibErrorInternal` if zlib rejects the
+/// options, e.g. a dictionary with gzip framing.
++ (nullable NSData *)gul_dataByDeflatingData:(NSData *)data
+                                     options:(GULNSDataZlibOptions *)options
+                                       error:(NSError **)error;
+
+/// Returns the result of decompressing the payload of |data|, which must use the framing and preset
+/// dictionary in |options|.
++ (nullable NSData *)gul_dataByInflatingData:(NSData *)data
+                                     options:(GULNSDataZlibOptions *)options
+                                       error:(NSError **)error;
+
+/// Like `gul_dataByGzippingData:error:`, but payloads longer than `concurrencyThreshold` bytes are
+/// split into 128 KB blocks that are compressed concurrently on all cores. The blocks are stitched
+/// into a single standard gzip member that is only slightly larger than the serial output. Shorter
+/// payloads are compressed serially.
++ (nullable NSData *)gul_dataByGzippingData:(NSData *)data
+                       concurrencyThreshold:(NSUInteger)concurrencyThreshold
+                                      error:(NSError **)error;
+
 FOUNDATION_EXPORT NSString *const GULNSDataZlibErrorDomain;
 FOUNDATION_EXPORT NSString *const GULNSDataZlibErrorKey;           // NSNumber
 FOUNDATION_EXPORT NSString *const GULNSDataZlibRemainingBytesKey;  // NSNumber
 
 typedef NS_ENUM(NSInteger, GULNSDataZlibError) {
+  // No longer returned; inputs larger than 4 GB are compressed in 32-bit windows.
   GULNSDataZlibErrorGreaterThan32BitsToCompress = 1024,
   // An internal zlib error.
   // GULNSDataZlibErrorKey will contain the error value.
@@ -45,7 +69,17 @@ typedef NS_ENUM(NSInteger, GULNSDataZlibError) {
   GULNSDataZlibErrorInternal,
   // There was left over data in the buffer that was not used.
   // GULNSDataZlibRemainingBytesKey will contain number of remaining bytes.
-  GULNSDataZlibErrorDataRemaining
+  GULNSDataZlibErrorDataRemaining,
+  // The output handler, stream or file descriptor of a GULGzipEncoder or GULGzipDecoder failed to
+  // accept a chunk. NSUnderlyingErrorKey may contain the stream or POSIX error.
+  GULNSDataZlibErrorOutputWriteFailed,
+  // A GULGzipEncoder or GULGzipDecoder was used after it was finished.
+  GULNSDataZlibErrorStreamFinished,
+  // A GULGzipDecoder was finished before the end of the compressed stream was reached.
+  GULNSDataZlibErrorIncompleteStream,
+  // The source file of +[GULGzipEncoder gzipFileAtPath:...] could not be opened or mapped.
+  // NSUnderlyingErrorKey contains the POSIX error.
+  GULNSDataZlibErrorInputReadFailed
 };
 
 @end
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The framing around deflate data.
+typedef NS_ENUM(NSInteger, GULNSDataZlibFormat) {
+  /// A gzip header and CRC-32 trailer (RFC 1952). When inflating, zlib framing is accepted too.
+  GULNSDataZlibFormatGzip = 0,
+  /// A zlib header and Adler-32 trailer (RFC 1950).
+  GULNSDataZlibFormatZlib,
+  /// Raw deflate data without any header or trailer (RFC 1951).
+  GULNSDataZlibFormatRaw,
+};
+
+/// The deflate strategy. The values match the corresponding zlib constants.
+typedef NS_ENUM(NSInteger, GULNSDataZlibStrategy) {
+  /// `Z_DEFAULT_STRATEGY`, for general data.
+  GULNSDataZlibStrategyDefault = 0,
+  /// `Z_FILTERED`, for data of small, somewhat random values.
+  GULNSDataZlibStrategyFiltered = 1,
+  /// `Z_HUFFMAN_ONLY`, which skips string matching entirely.
+  GULNSDataZlibStrategyHuffmanOnly = 2,
+  /// `Z_RLE`, which only matches runs; nearly as fast as Huffman only.
+  GULNSDataZlibStrategyRLE = 3,
+  /// `Z_FIXED`, which avoids dynamic Huffman codes.
+  GULNSDataZlibStrategyFixed = 4,
+};
+
+/// The default compression level, equivalent to level 6.
+FOUNDATION_EXPORT const NSInteger GULNSDataZlibDefaultCompressionLevel;
+
+/// Parameters for `+[NSData gul_dataByDeflatingData:options:error:]` and
+/// `+[NSData gul_dataByInflatingData:options:error:]`. The defaults produce gzip at the default
+/// level, like `gul_dataByGzippingData:error:`.
+@interface GULNSDataZlibOptions : NSObject <NSCopying>
+
+/// The compression level, from 0 (store) to 9 (best), or `GULNSDataZlibDefaultCompressionLevel`.
+/// Ignored when inflating.
+@property(nonatomic) NSInteger level;
+
+/// The deflate strategy. Ignored when inflating.
+@property(nonatomic) GULNSDataZlibStrategy strategy;
+
+/// The framing around the deflate data. Defaults to `GULNSDataZlibFormatGzip`.
+@property(nonatomic) GULNSDataZlibFormat format;
+
+/// A preset dictionary of strings likely to occur in the data, most common last, e.g. the keys
+/// shared by small JSON payloads. Data compressed with a dictionary can only be inflated with the
+/// same dictionary. gzip framing has no way to signal a dictionary, so it requires
+/// `GULNSDataZlibFormatZlib` or `GULNSDataZlibFormatRaw`. zlib only primes its window with the last
+/// 32 KB, but the dictionary id in zlib headers covers the whole dictionary, so the same full
+/// dictionary must be used on both sides.
+@property(nonatomic, copy, nullable) NSData *dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,174 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULConcurrentDictionary.h"
+
+#import <os/lock.h>
+#import <stdlib.h>
+
+/// The most stripes a dictionary has.
+static const NSUInteger kGULConcurrentDictionaryMaximumStripeCount = 1024;
+
+/// A lock and the objects it guards. Aligned to 128 bytes, the cache line size of Apple silicon, so
+/// that threads locking neighboring stripes don't contend for the same cache line.
+typedef struct {
+  os_unfair_lock lock;
+  /// Owned by `_storage`.
+  __unsafe_unretained NSMutableDictionary *objects;
+} __attribute__((aligned(128))) GULConcurrentDictionaryStripe;
+
+@implementation GULConcurrentDictionary {
+  /// `_stripeCount` stripes.
+  GULConcurrentDictionaryStripe *_stripes;
+
+  /// Keeps the dictionaries of the stripes alive.
+  NSArray<NSMutableDictionary *> *_storage;
+}
+
+- (instancetype)init {
+  return [self initWithStripeCount:[NSProcessInfo processInfo].activeProcessorCount * 2];
+}
+
+- (instancetype)initWithStripeCount:(NSUInteger)stripeCount {
+  self = [super init];
+
+  if (self) {
+    _stripeCount = 1;
+    while (_stripeCount < MIN(stripeCount, kGULConcurrentDictionaryMaximumStripeCount)) {
+      _stripeCount *= 2;
+    }
+    void *stripes = NULL;
+    if (posix_memalign(&stripes, _Alignof(GULConcurrentDictionaryStripe),
+                       _stripeCount * sizeof(GULConcurrentDictionaryStripe)) != 0) {
+      return nil;
+    }
+    _stripes = stripes;
+
+    NSMutableArray<NSMutableDictionary *> *storage =
+        [NSMutableArray arrayWithCapacity:_stripeCount];
+    for (NSUInteger i = 0; i < _stripeCount; i++) {
+      NSMutableDictionary *objects = [[NSMutableDictionary alloc] init];
+      [storage addObject:objects];
+      _stripes[i].lock = OS_UNFAIR_LOCK_INIT;
+      _stripes[i].objects = objects;
+    }
+    _storage = [storage copy];
+  }
+
+  return self;
+}
+
+- (void)dealloc {
+  free(_stripes);
+}
+
+/// Returns the stripe of `key`. Hashes such as those of small NSNumbers are sequential, so the hash
+/// is mixed with a Fibonacci multiplier and the stripe is chosen by its high bits.
+- (GULConcurrentDictionaryStripe *)stripeForKey:(id)key {
+  uint64_t hash = (uint64_t)[key hash] * 0x9E3779B97F4A7C15ull;
+  return &_stripes[(hash >> 32) & (_stripeCount - 1)];
+}
+
+#pragma mark - Accessors and mutators
+
+- (NSString *)description {
+  return self.dictionary.description;
+}
+
+- (id)objectForKey:(id)key {
+  GULConcurrentDictionaryStripe *stripe = [self stripeForKey:key];
+  os_unfair_lock_lock(&stripe->lock);
+  id object = [stripe->objects objectForKey:key];
+  os_unfair_lock_unlock(&stripe->lock);
+  return object;
+}
+
+- (void)setObject:(id)object forKey:(id<NSCopying>)key {
+  GULConcurrentDictionaryStripe *stripe = [self stripeForKey:key];
+  os_unfair_lock_lock(&stripe->lock);
+  // Released after unlocking, so that it may access the dictionary when it is deallocated.
+  NS_VALID_UNTIL_END_OF_SCOPE id replacedObject = [stripe->objects objectForKey:key];
+  [stripe->objects setObject:object forKey:key];
+  os_unfair_lock_unlock(&stripe->lock);
+}
+
+- (void)removeObjectForKey:(id)key {
+  GULConcurrentDictionaryStripe *stripe = [self stripeForKey:key];
+  os_unfair_lock_lock(&stripe->lock);
+  NS_VALID_UNTIL_END_OF_SCOPE id removedObject = [stripe->objects objectForKey:key];
+  [stripe->objects removeObjectForKey:key];
+  os_unfair_lock_unlock(&stripe->lock);
+}
+
+- (void)removeAllObjects {
+  for (NSUInteger i = 0; i < _stripeCount; i++) {
+    GULConcurrentDictionaryStripe *stripe = &_stripes[i];
+    os_unfair_lock_lock(&stripe->lock);
+    NS_VALID_UNTIL_END_OF_SCOPE NSDictionary *removedObjects = [stripe->objects copy];
+    [stripe->objects removeAllObjects];
+    os_unfair_lock_unlock(&stripe->lock);
+  }
+}
+
+- (NSUInteger)count {
+  NSUInteger count = 0;
+  for (NSUInteger i = 0; i < _stripeCount; i++) {
+    GULConcurrentDictionaryStripe *stripe = &_stripes[i];
+    os_unfair_lock_lock(&stripe->lock);
+    count += stripe->objects.count;
+    os_unfair_lock_unlock(&stripe->lock);
+  }
+  return count;
+}
+
+- (id)objectForKeyedSubscript:(id<NSCopying>)key {
+  return [self objectForKey:key];
+}
+
+- (void)setObject:(id)obj forKeyedSubscript:(id<NSCopying>)key {
+  if (obj) {
+    [self setObject:obj forKey:key];
+  } else {
+    [self removeObjectForKey:key];
+  }
+}
+
+- (NSDictionary *)dictionary {
+  NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] init];
+  for (NSUInteger i = 0; i < _stripeCount; i++) {
+    GULConcurrentDictionaryStripe *stripe = &_stripes[i];
+    os_unfair_lock_lock(&stripe->lock);
+    [dictionary addEntriesFromDictionary:stripe->objects];
+    os_unfair_lock_unlock(&stripe->lock);
+  }
+  return [dictionary copy];
+}
+
+- (void)enumerateKeysAndObjectsUsingBlock:
+    (void(NS_NOESCAPE ^)(id key, id object, BOOL *stop))block {
+  __block BOOL stop = NO;
+  for (NSUInteger i = 0; i < _stripeCount && !stop; i++) {
+    GULConcurrentDictionaryStripe *stripe = &_stripes[i];
+    os_unfair_lock_lock(&stripe->lock);
+    NSDictionary *objects = stripe->objects.count > 0 ? [stripe->objects copy] : nil;
+    os_unfair_lock_unlock(&stripe->lock);
+
+    [objects enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stopStripe) {
+      block(key, object, &stop);
+      *stopStripe = stop;
+    }];
+  }
+}
+
+@end
@@ -14,88 +14,484 @@
 
 #import "GoogleUtilities/Network/Public/GoogleUtilities/GULMutableDictionary.h"
 
+#import <os/lock.h>
+#import <pthread.h>
+#import <stdlib.h>
+
+/// What a write does.
+typedef NS_ENUM(uint8_t, GULMutableDictionaryWriteKind) {
+  /// Sets the object for the key.
+  GULMutableDictionaryWriteKindSet,
+  /// Removes the object for the key.
+  GULMutableDictionaryWriteKindRemove,
+  /// Removes all objects.
+  GULMutableDictionaryWriteKindRemoveAll,
+};
+
+/// A write to a serial dictionary that is not applied yet.
+typedef struct {
+  GULMutableDictionaryWriteKind kind;
+  /// Retained, or NULL for `GULMutableDictionaryWriteKindRemoveAll`.
+  CFTypeRef key;
+  /// Retained, or NULL unless `kind` is `GULMutableDictionaryWriteKindSet`.
+  CFTypeRef object;
+} GULMutableDictionaryPendingWrite;
+
+static void GULMutableDictionaryApplyPendingWritesOnQueue(void *context);
+
+/// The queue-specific key whose value on the queue of a serial dictionary is the dictionary.
+static char kGULMutableDictionaryQueueKey;
+
+/// Asserts that a `pthread_rwlock_*` call returned 0. It fails with EDEADLK when the dictionary is
+/// accessed from a block of one of its compound operations, and otherwise only if the lock is
+/// corrupt, in which case `_objects` is not protected anymore.
+static void GULMutableDictionaryCheckLockResult(int result) {
+  NSCAssert(result == 0, @"GULMutableDictionary lock operation failed: %d", result);
+}
+
+/// The storage of a dictionary as passed to `performBatchUpdates:`. Keeps the objects that the
+/// updates replace or remove, so that they are released after the dictionary is unlocked, and
+/// notes whether the updates changed anything.
+@interface GULMutableDictionaryBatch : NSMutableDictionary
+
+/// The replaced and removed objects, if any.
+@property(nonatomic, readonly, nullable) NSMutableArray *removedObjects;
+
+/// Whether an object was set or removed.
+@property(nonatomic, readonly) BOOL mutated;
+
+- (instancetype)initWithObjects:(NSMutableDictionary *)objects;
+
+@end
+
+@implementation GULMutableDictionaryBatch {
+  NSMutableDictionary *_objects;
+}
+
+- (instancetype)initWithObjects:(NSMutableDictionary *)objects {
+  self = [super init];
+  if (self) {
+    _objects = objects;
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _objects.count;
+}
+
+- (id)objectForKey:(id)key {
+  return [_objects objectForKey:key];
+}
+
+- (NSEnumerator *)keyEnumerator {
+  return [_objects keyEnumerator];
+}
+
+- (void)setObject:(id)object forKey:(id<NSCopying>)key {
+  [self keepObjectForKey:key];
+  [_objects setObject:object forKey:key];
+  _mutated = YES;
+}
+
+- (void)removeObjectForKey:(id)key {
+  if ([self keepObjectForKey:key]) {
+    [_objects removeObjectForKey:key];
+    _mutated = YES;
+  }
+}
+
+/// Keeps the object for `key`, if any, and returns whether there was one.
+- (BOOL)keepObjectForKey:(id)key {
+  id object = [_objects objectForKey:key];
+  if (!object) {
+    return NO;
+  }
+  if (!_removedObjects) {
+    _removedObjects = [NSMutableArray array];
+  }
+  [_removedObjects addObject:object];
+  return YES;
+}
+
+@end
+
 @implementation GULMutableDictionary {
   /// The mutable dictionary.
   NSMutableDictionary *_objects;
 
-  /// Serial synchronization queue. All reads should use dispatch_sync, while writes use
-  /// dispatch_async.
+  /// A retained immutable copy of `_objects` returned by `dictionary`, or NULL if it was not taken
+  /// since the last write. Published by concurrent readers, so atomic.
+  CFTypeRef _snapshot;
+
+  /// Serial synchronization queue of `GULMutableDictionaryConcurrencySerial`. Reads use
+  /// dispatch_sync, while writes are added to `_pendingWrites`, which every block on the queue
+  /// applies before it accesses `_objects`.
   dispatch_queue_t _queue;
+
+  /// Guards `_pendingWrites`, `_pendingWriteCount` and `_pendingWriteCapacity`.
+  os_unfair_lock _pendingWritesLock;
+
+  /// The writes to a serial dictionary that are not applied yet, in the order they were made.
+  GULMutableDictionaryPendingWrite *_pendingWrites;
+  NSUInteger _pendingWriteCount;
+  NSUInteger _pendingWriteCapacity;
+
+  /// An empty buffer that replaces `_pendingWrites` when they are applied, so that writes don't
+  /// allocate once both buffers have grown. Only accessed on the queue.
+  GULMutableDictionaryPendingWrite *_spareWrites;
+  NSUInteger _spareWriteCapacity;
+
+  /// Guards `_objects` with `GULMutableDictionaryConcurrencyConcurrentReads`.
+  pthread_rwlock_t _lock;
 }
 
 - (instancetype)init {
+  return [self initWithConcurrency:GULMutableDictionaryConcurrencySerial];
+}
+
+- (instancetype)initWithConcurrency:(GULMutableDictionaryConcurrency)concurrency {
   self = [super init];
 
   if (self) {
+    _concurrency = concurrency;
     _objects = [[NSMutableDictionary alloc] init];
-    _queue = dispatch_queue_create("GULMutableDictionary", DISPATCH_QUEUE_SERIAL);
+    if (concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+      GULMutableDictionaryCheckLockResult(pthread_rwlock_init(&_lock, NULL));
+    } else {
+      _queue = dispatch_queue_create("GULMutableDictionary", DISPATCH_QUEUE_SERIAL);
+      dispatch_queue_set_specific(_queue, &kGULMutableDictionaryQueueKey, (__bridge void *)self,
+                                  NULL);
+      _pendingWritesLock = OS_UNFAIR_LOCK_INIT;
+    }
   }
 
   return self;
 }
 
+- (void)dealloc {
+  if (_concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+    GULMutableDictionaryCheckLockResult(pthread_rwlock_destroy(&_lock));
+  }
+  if (_snapshot) {
+    CFRelease(_snapshot);
+  }
+  // Pending writes keep the dictionary alive until they are applied, so there are none left.
+  free(_pendingWrites);
+  free(_spareWrites);
+}
+
+#pragma mark - Synchronization
+
+/// Asserts that the calling code does not run on the queue of the dictionary, where `dispatch_sync`
+/// onto it would deadlock, e.g. in a block of a compound operation.
+- (void)assertNotOnQueue {
+  NSAssert(dispatch_get_specific(&kGULMutableDictionaryQueueKey) != (__bridge void *)self,
+           @"A GULMutableDictionary was accessed from one of its own compound operations.");
+}
+
+/// Runs `block` while no write is in progress, on the queue after applying the pending writes or
+/// holding the lock for reading.
+- (void)readWithBlock:(void(NS_NOESCAPE ^)(void))block {
+  if (_concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+    GULMutableDictionaryCheckLockResult(pthread_rwlock_rdlock(&_lock));
+    block();
+    GULMutableDictionaryCheckLockResult(pthread_rwlock_unlock(&_lock));
+  } else {
+    [self assertNotOnQueue];
+    dispatch_sync(_queue, ^{
+      [self applyPendingWrites];
+      block();
+    });
+  }
+}
+
+/// Makes a write of `kind` with `object` and `key`, which must be nil where
+/// `GULMutableDictionaryPendingWrite` has NULL.
+///
+/// A serial dictionary adds the write to its pending writes, and only schedules applying them on
+/// the queue if there were none, so that a burst of writes wakes the queue up once and allocates
+/// nothing per write. Reads, compound operations and `flush` apply pending writes first, so they
+/// see every write that returned before them even if it was not applied yet.
+- (void)write:(GULMutableDictionaryWriteKind)kind
+       object:(nullable id)object
+       forKey:(nullable id)key {
+  if (_concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+    [self writeHoldingLockWithBlock:^id(BOOL *mutated) {
+      *mutated = YES;
+      return [self apply:kind object:object forKey:key];
+    }];
+    return;
+  }
+
+  GULMutableDictionaryPendingWrite write = {
+      .kind = kind,
+      .key = key ? CFBridgingRetain(key) : NULL,
+      .object = object ? CFBridgingRetain(object) : NULL,
+  };
+  os_unfair_lock_lock(&_pendingWritesLock);
+  if (_pendingWriteCount == _pendingWriteCapacity) {
+    NSUInteger capacity = MAX(_pendingWriteCapacity * 2, 16);
+    GULMutableDictionaryPendingWrite *writes =
+        realloc(_pendingWrites, capacity * sizeof(GULMutableDictionaryPendingWrite));
+    if (!writes) {
+      os_unfair_lock_unlock(&_pendingWritesLock);
+      // The pending writes stay as they are; apply this one after them and wait for it instead.
+      [self writeAndWaitWithBlock:^id(BOOL *mutated) {
+        *mutated = YES;
+        return [self apply:write.kind
+                    object:CFBridgingRelease(write.object)
+                    forKey:CFBridgingRelease(write.key)];
+      }];
+      return;
+    }
+    _pendingWrites = writes;
+    _pendingWriteCapacity = capacity;
+  }
+  _pendingWrites[_pendingWriteCount++] = write;
+  BOOL scheduleApplying = _pendingWriteCount == 1;
+  os_unfair_lock_unlock(&_pendingWritesLock);
+
+  if (scheduleApplying) {
+    dispatch_async_f(_queue, (__bridge_retained void *)self,
+                     GULMutableDictionaryApplyPendingWritesOnQueue);
+  }
+}
+
+/// Applies the pending writes of a serial dictionary in one batch. Must be called on the queue.
+- (void)applyPendingWrites {
+  os_unfair_lock_lock(&_pendingWritesLock);
+  GULMutableDictionaryPendingWrite *writes = _pendingWrites;
+  NSUInteger writeCount = _pendingWriteCount;
+  NSUInteger writeCapacity = _pendingWriteCapacity;
+  if (writeCount > 0) {
+    _pendingWrites = _spareWrites;
+    _pendingWriteCount = 0;
+    _pendingWriteCapacity = _spareWriteCapacity;
+  }
+  os_unfair_lock_unlock(&_pendingWritesLock);
+  if (writeCount == 0) {
+    return;
+  }
+
+  @autoreleasepool {
+    [self invalidateSnapshot];
+    for (NSUInteger i = 0; i < writeCount; i++) {
+      [self apply:writes[i].kind
+           object:CFBridgingRelease(writes[i].object)
+           forKey:CFBridgingRelease(writes[i].key)];
+    }
+  }
+  _spareWrites = writes;
+  _spareWriteCapacity = writeCapacity;
+}
+
+/// Applies `GULMutableDictionary` pending writes scheduled by `write:object:forKey:`, and releases
+/// the dictionary retained for them.
+static void GULMutableDictionaryApplyPendingWritesOnQueue(void *context) {
+  GULMutableDictionary *dictionary = (__bridge_transfer GULMutableDictionary *)context;
+  [dictionary applyPendingWrites];
+}
+
+/// Applies a write as described in `write:object:forKey:` to `_objects`, and returns the replaced
+/// or removed objects. Must be called with exclusive access.
+- (nullable id)apply:(GULMutableDictionaryWriteKind)kind
+              object:(nullable id)object
+              forKey:(nullable id)key {
+  if (kind == GULMutableDictionaryWriteKindRemoveAll) {
+    NSMutableDictionary *removedObjects = _objects;
+    _objects = [[NSMutableDictionary alloc] init];
+    return removedObjects;
+  }
+  id replacedObject = _objects[key];
+  if (kind == GULMutableDictionaryWriteKindSet) {
+    _objects[key] = object;
+  } else {
+    [_objects removeObjectForKey:key];
+  }
+  return replacedObject;
+}
+
+/// Runs `block` with exclusive access to `_objects` and returns after it ran, on the queue after
+/// applying the pending writes or holding the lock for writing. `block` sets `mutated` to YES if it
+/// changed `_objects`, so that the snapshot taken by `dictionary`, if any, is dropped; otherwise the
+/// snapshot stays valid. What `block` returns and the dropped snapshot are released only after the
+/// lock is unlocked or the queue is left, so that objects it removes from the dictionary may access
+/// the dictionary when they are deallocated.
+- (void)writeAndWaitWithBlock:(id(NS_NOESCAPE ^)(BOOL *mutated))block {
+  if (_concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+    [self writeHoldingLockWithBlock:block];
+  } else {
+    [self assertNotOnQueue];
+    __block NS_VALID_UNTIL_END_OF_SCOPE NSDictionary *snapshot;
+    __block NS_VALID_UNTIL_END_OF_SCOPE id removedObjects;
+    dispatch_sync(_queue, ^{
+      [self applyPendingWrites];
+      BOOL mutated = NO;
+      removedObjects = block(&mutated);
+      if (mutated) {
+        snapshot = [self invalidateSnapshot];
+      }
+    });
+  }
+}
+
+/// Runs `block` holding the lock for writing, as described in `writeAndWaitWithBlock:`.
+- (void)writeHoldingLockWithBlock:(id(NS_NOESCAPE ^)(BOOL *mutated))block {
+  GULMutableDictionaryCheckLockResult(pthread_rwlock_wrlock(&_lock));
+  BOOL mutated = NO;
+  NS_VALID_UNTIL_END_OF_SCOPE id removedObjects = block(&mutated);
+  NS_VALID_UNTIL_END_OF_SCOPE NSDictionary *snapshot = mutated ? [self invalidateSnapshot] : nil;
+  GULMutableDictionaryCheckLockResult(pthread_rwlock_unlock(&_lock));
+}
+
+/// Clears the snapshot once `_objects` was written, and returns it, if any, so that it can be
+/// released after the lock is unlocked or the queue is left. Must be called with exclusive access.
+- (nullable NSDictionary *)invalidateSnapshot {
+  CFTypeRef snapshot = __atomic_exchange_n(&_snapshot, NULL, __ATOMIC_RELAXED);
+  return snapshot ? CFBridgingRelease(snapshot) : nil;
+}
+
+#pragma mark - Accessors and mutators
+
 - (NSString *)description {
   __block NSString *description;
-  dispatch_sync(_queue, ^{
+  [self readWithBlock:^{
     description = self->_objects.description;
-  });
+  }];
   return description;
 }
 
 - (id)objectForKey:(id)key {
   __block id object;
-  dispatch_sync(_queue, ^{
+  [self readWithBlock:^{
     object = [self->_objects objectForKey:key];
-  });
+  }];
   return object;
 }
 
 - (void)setObject:(id)object forKey:(id<NSCopying>)key {
-  dispatch_async(_queue, ^{
-    [self->_objects setObject:object forKey:key];
-  });
+  NSAssert(object && key, @"GULMutableDictionary cannot set a nil object or key.");
+  if (object && key) {
+    [self write:GULMutableDictionaryWriteKindSet object:object forKey:key];
+  }
 }
 
 - (void)removeObjectForKey:(id)key {
-  dispatch_async(_queue, ^{
-    [self->_objects removeObjectForKey:key];
-  });
+  if (key) {
+    [self write:GULMutableDictionaryWriteKindRemove object:nil forKey:key];
+  }
 }
 
 - (void)removeAllObjects {
-  dispatch_async(_queue, ^{
-    [self->_objects removeAllObjects];
-  });
+  [self write:GULMutableDictionaryWriteKindRemoveAll object:nil forKey:nil];
 }
 
 - (NSUInteger)count {
   __block NSUInteger count;
-  dispatch_sync(_queue, ^{
+  [self readWithBlock:^{
     count = self->_objects.count;
-  });
+  }];
   return count;
 }
 
 - (id)objectForKeyedSubscript:(id<NSCopying>)key {
   __block id object;
-  dispatch_sync(_queue, ^{
+  [self readWithBlock:^{
     object = self->_objects[key];
-  });
+  }];
   return object;
 }
 
 - (void)setObject:(id)obj forKeyedSubscript:(id<NSCopying>)key {
-  dispatch_async(_queue, ^{
-    self->_objects[key] = obj;
-  });
+  // Like NSMutableDictionary, setting nil through a subscript removes the object.
+  if (obj) {
+    [self setObject:obj forKey:key];
+  } else {
+    [self removeObjectForKey:key];
+  }
+}
+
+- (void)flush {
+  if (_concurrency == GULMutableDictionaryConcurrencySerial) {
+    [self assertNotOnQueue];
+    dispatch_sync(_queue, ^{
+      [self applyPendingWrites];
+    });
+  }
 }
 
 - (NSDictionary *)dictionary {
   __block NSDictionary *dictionary;
-  dispatch_sync(_queue, ^{
-    dictionary = [self->_objects copy];
-  });
+  [self readWithBlock:^{
+    CFTypeRef snapshot = __atomic_load_n(&self->_snapshot, __ATOMIC_ACQUIRE);
+    if (!snapshot) {
+      // Concurrent readers may copy the same version; the first to publish its copy wins.
+      CFTypeRef copy = CFBridgingRetain([self->_objects copy]);
+      if (__atomic_compare_exchange_n(&self->_snapshot, &snapshot, copy, NO, __ATOMIC_ACQ_REL,
+                                      __ATOMIC_ACQUIRE)) {
+        snapshot = copy;
+      } else {
+        CFRelease(copy);
+      }
+    }
+    dictionary = (__bridge NSDictionary *)snapshot;
+  }];
   return dictionary;
 }
 
+#pragma mark - Compound operations
+
+- (id)objectForKey:(id<NSCopying>)key orInsert:(id(NS_NOESCAPE ^)(void))block {
+  // Readers don't wait for each other, so try reading first.
+  __block id object;
+  if (_concurrency == GULMutableDictionaryConcurrencyConcurrentReads) {
+    object = [self objectForKey:key];
+    if (object) {
+      return object;
+    }
+  }
+
+  [self writeAndWaitWithBlock:^id(BOOL *mutated) {
+    object = [self->_objects objectForKey:key];
+    if (!object) {
+      object = block();
+      if (object) {
+        [self->_objects setObject:object forKey:key];
+        *mutated = YES;
+      }
+    }
+    return nil;
+  }];
+  return object;
+}
+
+- (BOOL)compareAndSetObject:(id)object forKey:(id<NSCopying>)key expectedObject:(id)expectedObject {
+  __block BOOL isExpected;
+  [self writeAndWaitWithBlock:^id(BOOL *mutated) {
+    id currentObject = [self->_objects objectForKey:key];
+    isExpected = currentObject == expectedObject || [currentObject isEqual:expectedObject];
+    if (isExpected) {
+      self->_objects[key] = object;
+      *mutated = YES;
+    }
+    return currentObject;
+  }];
+  return isExpected;
+}
+
+- (BOOL)removeObjectForKey:(id<NSCopying>)key ifEqualTo:(id)object {
+  return [self compareAndSetObject:nil forKey:key expectedObject:object];
+}
+
+- (void)performBatchUpdates:(void(NS_NOESCAPE ^)(NSMutableDictionary *objects))updates {
+  [self writeAndWaitWithBlock:^id(BOOL *mutated) {
+    GULMutableDictionaryBatch *batch =
+        [[GULMutableDictionaryBatch alloc] initWithObjects:self->_objects];
+    updates(batch);
+    *mutated = batch.mutated;
+    return batch.removedObjects;
+  }];
+}
+
 @end
@@ -71,7 +71,8 @@ static NSString *const kGULNetworkLogTag = @"Google/Utilities/Network";
       return nil;
     }
 
-    _requests = [[GULMutableDictionary alloc] init];
+    _requests = [[GULMutableDictionary alloc]
+        initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
     _timeoutInterval = kGULNetworkTimeOutInterval;
   }
   return self;
@@ -19,6 +19,7 @@
 
 #import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
 #import "GoogleUtilities/Network/GULNetworkInternal.h"
+#import "GoogleUtilities/Network/GULNetworkURLSessionPool.h"
 #import "GoogleUtilities/Network/Public/GoogleUtilities/GULMutableDictionary.h"
 #import "GoogleUtilities/Network/Public/GoogleUtilities/GULNetworkConstants.h"
 #import "GoogleUtilities/Network/Public/GoogleUtilities/GULNetworkMessageCode.h"
@@ -84,6 +85,10 @@
   /// The current NSURLSession.
   NSURLSession *__weak _Nullable _URLSession;
 
+  /// Whether `_URLSession` is shared with other requests through `GULNetworkURLSessionPool`, in
+  /// which case it must not be invalidated.
+  BOOL _usesSharedURLSession;
+
   /// The path to the directory where all temporary files are stored before uploading.
   NSURL *_networkDirectoryURL;
 
@@ -154,8 +159,6 @@
   // Make a temporary file with the data subset.
   _uploadingFileURL = [self temporaryFilePathWithSessionID:_sessionID];
   NSError *writeError;
-  NSURLSessionUploadTask *postRequestTask;
-  NSURLSession *session;
   BOOL didWriteFile = NO;
 
   // Clean up the entire temp folder to avoid temp files that remain in case the previous session
@@ -189,9 +192,6 @@
     _sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
   }
   [self populateSessionConfig:_sessionConfig withRequest:request];
-  session = [NSURLSession sessionWithConfiguration:_sessionConfig
-                                          delegate:self
-                                     delegateQueue:[NSOperationQueue mainQueue]];
   // To avoid a runtime warning in Xcode 15 Beta 4, the given `URLRequest`
   // should have a nil `HTTPBody`. To workaround this, the given `URLRequest`
   // is copied and the `HTTPBody` data is removed.
@@ -199,15 +199,18 @@
   NSMutableURLRequest *requestWithoutHTTPBody = [request mutableCopy];
   requestWithoutHTTPBody.HTTPBody = nil;
 
-  if (didWriteFile) {
-    postRequestTask = [session uploadTaskWithRequest:requestWithoutHTTPBody
-                                            fromFile:_uploadingFileURL];
-  } else {
-    postRequestTask = [session uploadTaskWithRequest:requestWithoutHTTPBody
-                                            fromData:givenRequestHTTPBody];
-  }
-
-  if (!session || !postRequestTask) {
+  NSURLSessionTask *postRequestTask =
+      [self taskWithConfiguration:_sessionConfig
+                 createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                   if (didWriteFile) {
+                     return [session uploadTaskWithRequest:requestWithoutHTTPBody
+                                                  fromFile:self->_uploadingFileURL];
+                   }
+                   return [session uploadTaskWithRequest:requestWithoutHTTPBody
+                                                fromData:givenRequestHTTPBody];
+                 }];
+
+  if (!postRequestTask) {
     NSError *error = [[NSError alloc]
         initWithDomain:kGULNetworkErrorDomain
                   code:GULErrorCodeNetworkRequestCreation
@@ -216,8 +219,6 @@
     return nil;
   }
 
-  _URLSession = session;
-
   // Save the session into memory.
   [[self class] setSessionInFetcherMap:self forSessionID:_sessionID];
 
@@ -245,12 +246,13 @@
   // Do not cache the GET request.
   _sessionConfig.URLCache = nil;
 
-  NSURLSession *session = [NSURLSession sessionWithConfiguration:_sessionConfig
-                                                        delegate:self
-                                                   delegateQueue:[NSOperationQueue mainQueue]];
-  NSURLSessionDownloadTask *downloadTask = [session downloadTaskWithRequest:request];
+  NSURLSessionTask *downloadTask =
+      [self taskWithConfiguration:_sessionConfig
+                 createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                   return [session downloadTaskWithRequest:request];
+                 }];
 
-  if (!session || !downloadTask) {
+  if (!downloadTask) {
     NSError *error = [[NSError alloc]
         initWithDomain:kGULNetworkErrorDomain
                   code:GULErrorCodeNetworkRequestCreation
@@ -259,8 +261,6 @@
     return nil;
   }
 
-  _URLSession = session;
-
   // Save the session into memory.
   [[self class] setSessionInFetcherMap:self forSessionID:_sessionID];
 
@@ -363,8 +363,10 @@
                      expiringTime:kGULNetworkTempFolderExpireTime];
 
   // This is called without checking the sessionID here since non-background sessions
-  // won't have an ID.
-  [session finishTasksAndInvalidate];
+  // won't have an ID. Shared sessions are kept for the next request.
+  if (!_usesSharedURLSession) {
+    [session finishTasksAndInvalidate];
+  }
 
   // Explicitly remove the session so it won't be reused. The weak map table should
   // remove the session on deallocation, but dealloc may not happen immediately after
@@ -482,14 +484,17 @@
 
   GULMutableDictionary *systemCompletionHandlers =
       [[self class] sessionIDToSystemCompletionHandlerDictionary];
-  if (systemCompletionHandlers[identifier]) {
+  __block BOOL hasPreviousHandler;
+  [systemCompletionHandlers performBatchUpdates:^(NSMutableDictionary *handlers) {
+    hasPreviousHandler = handlers[identifier] != nil;
+    handlers[identifier] = handler;
+  }];
+  if (hasPreviousHandler) {
     [_loggerDelegate GULNetwork_logWithLevel:kGULNetworkLogLevelWarning
                                  messageCode:kGULNetworkMessageCodeURLSession011
                                      message:@"Got multiple system handlers for a single session ID"
                                      context:identifier];
   }
-
-  systemCompletionHandlers[identifier] = handler;
 }
 
 /// Calls the system provided completion handler with the session ID stored in the dictionary.
@@ -499,15 +504,39 @@
       [[self class] sessionIDToSystemCompletionHandlerDictionary];
   GULNetworkSystemCompletionHandler handler = [systemCompletionHandlers objectForKey:identifier];
 
-  if (handler) {
-    [systemCompletionHandlers removeObjectForKey:identifier];
-
+  // Only the caller that removes the handler calls it.
+  if (handler && [systemCompletionHandlers removeObjectForKey:identifier ifEqualTo:handler]) {
     dispatch_async(dispatch_get_main_queue(), ^{
       handler();
     });
   }
 }
 
+/// Creates a task with `block` in a new session for a background configuration, which is specific
+/// to this session ID, or else in the session shared by foreground requests with the same
+/// configuration, which then calls this session's delegate methods for the task. Sets `_URLSession`
+/// to the session.
+- (nullable NSURLSessionTask *)
+    taskWithConfiguration:(NSURLSessionConfiguration *)configuration
+         createdWithBlock:(NSURLSessionTask *_Nullable(NS_NOESCAPE ^)(NSURLSession *session))block {
+  _usesSharedURLSession = configuration.identifier == nil;
+  if (!_usesSharedURLSession) {
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration
+                                                          delegate:self
+                                                     delegateQueue:[NSOperationQueue mainQueue]];
+    _URLSession = session;
+    return session ? block(session) : nil;
+  }
+
+  return [[GULNetworkURLSessionPool sharedPool]
+      taskWithConfiguration:configuration
+                   delegate:self
+           createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+             self->_URLSession = session;
+             return block(session);
+           }];
+}
+
 /// Sets or updates the session ID of this session.
 - (void)setSessionID:(NSString *)sessionID {
   _sessionID = [sessionID copy];
@@ -738,7 +767,9 @@ static const void *kGULSessionTrackerKey = &kGULSessionTrackerKey;
         objc_getAssociatedObject(existingSession, kGULSessionTrackerKey);
     objc_setAssociatedObject(existingSession, kGULSessionTrackerKey, nil,
                              OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    [existingSession->_URLSession finishTasksAndInvalidate];
+    if (!existingSession->_usesSharedURLSession) {
+      [existingSession->_URLSession finishTasksAndInvalidate];
+    }
   }
   if (session) {
     GULNetworkURLSessionWeakHolder *newHolder = [[GULNetworkURLSessionWeakHolder alloc] init];
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The delegate of a task created with a session of a `GULNetworkURLSessionPool`.
+typedef id<NSURLSessionDataDelegate, NSURLSessionDownloadDelegate> GULNetworkURLSessionTaskDelegate;
+
+/// Long-lived foreground `NSURLSession`s, shared by all requests whose session configuration has
+/// the same properties, so that back-to-back requests reuse connections, TLS sessions, HTTP/2
+/// streams and the DNS cache instead of starting over with a new session each.
+///
+/// Every session calls its delegate methods on the main queue and routes them to the delegate of
+/// the task they are about. At most `maximumSessionCount` sessions are kept; when another is
+/// needed, the least recently used one finishes its tasks and is invalidated.
+@interface GULNetworkURLSessionPool : NSObject
+
+/// The pool used by `GULNetworkURLSession`.
+@property(class, nonatomic, readonly) GULNetworkURLSessionPool *sharedPool;
+
+@property(nonatomic, readonly) NSUInteger maximumSessionCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithMaximumSessionCount:(NSUInteger)maximumSessionCount
+    NS_DESIGNATED_INITIALIZER;
+
+/// Calls `block` with the session for the timeouts, cache policy and cache of `configuration`,
+/// creating the session with a copy of `configuration` without its additional headers if there is
+/// none, and returns the task `block` creates in it. The delegate methods of the task are called on
+/// `delegate`, which is retained until the task completes. `configuration` must not be a background
+/// configuration, as those are specific to one session.
+///
+/// `block` is called while the pool is locked, so the session cannot be evicted before the task
+/// exists; it must not use the pool.
+- (nullable NSURLSessionTask *)
+    taskWithConfiguration:(NSURLSessionConfiguration *)configuration
+                 delegate:(GULNetworkURLSessionTaskDelegate)delegate
+         createdWithBlock:(NSURLSessionTask *_Nullable(NS_NOESCAPE ^)(NSURLSession *session))block;
+
+/// Finishes the tasks of all sessions and invalidates them.
+- (void)invalidateSessions;
+
+@end
+
+NS_ASSUME_NONNULL_END
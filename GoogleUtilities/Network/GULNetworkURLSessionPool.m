@@ -0,0 +1,210 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleUtilities/Network/GULNetworkURLSessionPool.h"
+
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULMutableDictionary.h"
+
+/// The most sessions the shared pool keeps.
+static const NSUInteger kGULNetworkURLSessionPoolMaximumSessionCount = 4;
+
+/// The delegate of a pooled session, which passes the delegate methods about a task on to the
+/// delegate of the task.
+@interface GULNetworkURLSessionTaskRouter : NSObject <NSURLSessionDataDelegate,
+                                                      NSURLSessionDownloadDelegate>
+
+- (void)setDelegate:(GULNetworkURLSessionTaskDelegate)delegate forTask:(NSURLSessionTask *)task;
+
+@end
+
+@implementation GULNetworkURLSessionTaskRouter {
+  /// The delegates of the running tasks by task identifier. Written when a task is created and
+  /// when it completes, and read for every delegate method.
+  GULMutableDictionary *_delegatesByTaskIdentifier;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _delegatesByTaskIdentifier = [[GULMutableDictionary alloc]
+        initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
+  }
+  return self;
+}
+
+- (void)setDelegate:(GULNetworkURLSessionTaskDelegate)delegate forTask:(NSURLSessionTask *)task {
+  _delegatesByTaskIdentifier[@(task.taskIdentifier)] = delegate;
+}
+
+- (nullable GULNetworkURLSessionTaskDelegate)delegateForTask:(NSURLSessionTask *)task {
+  return _delegatesByTaskIdentifier[@(task.taskIdentifier)];
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+  GULNetworkURLSessionTaskDelegate delegate = [self delegateForTask:dataTask];
+  if ([delegate respondsToSelector:_cmd]) {
+    [delegate URLSession:session dataTask:dataTask didReceiveData:data];
+  }
+}
+
+#pragma mark - NSURLSessionDownloadDelegate
+
+- (void)URLSession:(NSURLSession *)session
+                 downloadTask:(NSURLSessionDownloadTask *)downloadTask
+    didFinishDownloadingToURL:(NSURL *)location {
+  [[self delegateForTask:downloadTask] URLSession:session
+                                     downloadTask:downloadTask
+                        didFinishDownloadingToURL:location];
+}
+
+#pragma mark - NSURLSessionTaskDelegate
+
+- (void)URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+    didCompleteWithError:(NSError *)error {
+  GULNetworkURLSessionTaskDelegate delegate = [self delegateForTask:task];
+  [_delegatesByTaskIdentifier removeObjectForKey:@(task.taskIdentifier)];
+  if ([delegate respondsToSelector:_cmd]) {
+    [delegate URLSession:session task:task didCompleteWithError:error];
+  }
+}
+
+- (void)URLSession:(NSURLSession *)session
+                   task:(NSURLSessionTask *)task
+    didReceiveChallenge:(NSURLAuthenticationChallenge *)challenge
+      completionHandler:(void (^)(NSURLSessionAuthChallengeDisposition disposition,
+                                  NSURLCredential *credential))completionHandler {
+  GULNetworkURLSessionTaskDelegate delegate = [self delegateForTask:task];
+  if ([delegate respondsToSelector:_cmd]) {
+    [delegate URLSession:session
+                       task:task
+        didReceiveChallenge:challenge
+          completionHandler:completionHandler];
+  } else {
+    completionHandler(NSURLSessionAuthChallengePerformDefaultHandling, nil);
+  }
+}
+
+- (void)URLSession:(NSURLSession *)session
+                          task:(NSURLSessionTask *)task
+    willPerformHTTPRedirection:(NSHTTPURLResponse *)response
+                    newRequest:(NSURLRequest *)request
+             completionHandler:(void (^)(NSURLRequest *))completionHandler {
+  GULNetworkURLSessionTaskDelegate delegate = [self delegateForTask:task];
+  if ([delegate respondsToSelector:_cmd]) {
+    [delegate URLSession:session
+                              task:task
+        willPerformHTTPRedirection:response
+                        newRequest:request
+                 completionHandler:completionHandler];
+  } else {
+    completionHandler(request);
+  }
+}
+
+@end
+
+@implementation GULNetworkURLSessionPool {
+  /// The sessions by the properties of their configuration that `GULNetworkURLSession` sets.
+  NSMutableDictionary<NSDictionary *, NSURLSession *> *_sessions;
+
+  /// The keys of `_sessions`, least recently used first.
+  NSMutableArray<NSDictionary *> *_sessionKeys;
+}
+
++ (GULNetworkURLSessionPool *)sharedPool {
+  static GULNetworkURLSessionPool *sharedPool;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedPool = [[GULNetworkURLSessionPool alloc]
+        initWithMaximumSessionCount:kGULNetworkURLSessionPoolMaximumSessionCount];
+  });
+  return sharedPool;
+}
+
+- (instancetype)initWithMaximumSessionCount:(NSUInteger)maximumSessionCount {
+  self = [super init];
+  if (self) {
+    _maximumSessionCount = MAX(maximumSessionCount, 1);
+    _sessions = [[NSMutableDictionary alloc] init];
+    _sessionKeys = [[NSMutableArray alloc] init];
+  }
+  return self;
+}
+
+- (nullable NSURLSessionTask *)
+    taskWithConfiguration:(NSURLSessionConfiguration *)configuration
+                 delegate:(GULNetworkURLSessionTaskDelegate)delegate
+         createdWithBlock:(NSURLSessionTask *_Nullable(NS_NOESCAPE ^)(NSURLSession *session))block {
+  NSAssert(!configuration.identifier, @"Background sessions cannot be shared.");
+  NSDictionary *key = @{
+    @"timeoutIntervalForRequest" : @(configuration.timeoutIntervalForRequest),
+    @"timeoutIntervalForResource" : @(configuration.timeoutIntervalForResource),
+    @"requestCachePolicy" : @(configuration.requestCachePolicy),
+    @"URLCache" : configuration.URLCache ?: [NSNull null],
+  };
+
+  NSURLSessionTask *task;
+  NSURLSession *evictedSession;
+  @synchronized(self) {
+    NSURLSession *session = _sessions[key];
+    if (session) {
+      [_sessionKeys removeObject:key];
+    } else {
+      // Requests carry their own headers, so sessions are shared regardless of them.
+      NSURLSessionConfiguration *sessionConfiguration = [configuration copy];
+      sessionConfiguration.HTTPAdditionalHeaders = nil;
+      session = [NSURLSession sessionWithConfiguration:sessionConfiguration
+                                              delegate:[[GULNetworkURLSessionTaskRouter alloc] init]
+                                         delegateQueue:[NSOperationQueue mainQueue]];
+      _sessions[key] = session;
+      if (_sessionKeys.count == _maximumSessionCount) {
+        NSDictionary *evictedKey = _sessionKeys.firstObject;
+        evictedSession = _sessions[evictedKey];
+        [_sessions removeObjectForKey:evictedKey];
+        [_sessionKeys removeObjectAtIndex:0];
+      }
+    }
+    [_sessionKeys addObject:key];
+
+    // Sessions are only evicted under the lock, so this one cannot be invalidated before the task
+    // exists in it, and the task is routed before it can be resumed.
+    task = block(session);
+    if (task) {
+      [(GULNetworkURLSessionTaskRouter *)session.delegate setDelegate:delegate forTask:task];
+    }
+  }
+
+  // Tasks that are still running complete and are routed to their delegates as before.
+  [evictedSession finishTasksAndInvalidate];
+  return task;
+}
+
+- (void)invalidateSessions {
+  NSArray<NSURLSession *> *sessions;
+  @synchronized(self) {
+    sessions = _sessions.allValues;
+    [_sessions removeAllObjects];
+    [_sessionKeys removeAllObjects];
+  }
+  for (NSURLSession *session in sessions) {
+    [session finishTasksAndInvalidate];
+  }
+}
+
+@end
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A mutable dictionary for state that many threads write concurrently, with the API of
+/// `GULMutableDictionary`.
+///
+/// Keys are spread by hash over a fixed number of stripes, each with its own lock and storage, so
+/// that threads writing keys of different stripes don't wait for each other. Operations on a single
+/// key are linearizable. `count`, `dictionary`, `description` and enumeration visit the stripes one
+/// at a time and are only weakly consistent: they reflect each stripe at some point during the
+/// call, but not necessarily the whole dictionary at a single instant.
+@interface GULConcurrentDictionary : NSObject
+
+/// The number of stripes, a power of two.
+@property(nonatomic, readonly) NSUInteger stripeCount;
+
+/// Creates a dictionary with two stripes per active processor, rounded up to a power of two.
+- (instancetype)init;
+
+/// Creates a dictionary with `stripeCount` stripes, rounded up to a power of two of at most 1024.
+- (instancetype)initWithStripeCount:(NSUInteger)stripeCount NS_DESIGNATED_INITIALIZER;
+
+/// Returns an object given a key in the dictionary or nil if not found.
+- (nullable id)objectForKey:(id)key;
+
+/// Updates the object given its key or adds it to the dictionary if it is not in the dictionary.
+- (void)setObject:(id)object forKey:(id<NSCopying>)key;
+
+/// Removes the object given its key from the dictionary.
+- (void)removeObjectForKey:(id)key;
+
+/// Removes all objects, one stripe at a time.
+- (void)removeAllObjects;
+
+/// Returns the number of objects in the dictionary. Weakly consistent.
+- (NSUInteger)count;
+
+/// Returns an object given a key in the dictionary or nil if not found.
+- (nullable id)objectForKeyedSubscript:(id<NSCopying>)key;
+
+/// Updates the object given its key or removes it from the dictionary if `obj` is nil.
+- (void)setObject:(nullable id)obj forKeyedSubscript:(id<NSCopying>)key;
+
+/// Returns an immutable copy of the objects. Weakly consistent.
+- (NSDictionary *)dictionary;
+
+/// Calls `block` with the objects of one stripe after another. Each stripe is copied under its lock
+/// and `block` is called without holding any lock, so it may access the dictionary. Weakly
+/// consistent.
+- (void)enumerateKeysAndObjectsUsingBlock:(void(NS_NOESCAPE ^)(id key, id object, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
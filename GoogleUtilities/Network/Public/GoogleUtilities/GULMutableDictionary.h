@@ -18,9 +18,28 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// How a `GULMutableDictionary` synchronizes access to its objects. Either way, every read sees all
+/// the writes that returned before it started.
+typedef NS_ENUM(NSInteger, GULMutableDictionaryConcurrency) {
+  /// Reads and writes run one at a time on a private serial queue. Writes return before they are
+  /// applied, and writes made in a burst are applied together in one batch. The default.
+  GULMutableDictionaryConcurrencySerial = 0,
+  /// Reads run concurrently under a reader/writer lock, and writes wait for exclusive access and
+  /// are applied before they return. For dictionaries that are read much more often than written.
+  GULMutableDictionaryConcurrencyConcurrentReads = 1,
+};
+
 /// A mutable dictionary that provides atomic accessor and mutators.
 @interface GULMutableDictionary : NSObject
 
+@property(nonatomic, readonly) GULMutableDictionaryConcurrency concurrency;
+
+/// Creates a dictionary with `GULMutableDictionaryConcurrencySerial`.
+- (instancetype)init;
+
+- (instancetype)initWithConcurrency:(GULMutableDictionaryConcurrency)concurrency
+    NS_DESIGNATED_INITIALIZER;
+
 /// Returns an object given a key in the dictionary or nil if not found.
 - (id)objectForKey:(id)key;
 
@@ -40,11 +59,43 @@ NS_ASSUME_NONNULL_BEGIN
 - (id)objectForKeyedSubscript:(id<NSCopying>)key;
 
 /// Updates the object given its key or adds it to the dictionary if it is not in the dictionary.
-- (void)setObject:(id)obj forKeyedSubscript:(id<NSCopying>)key;
+/// Setting nil removes the object, as with NSMutableDictionary.
+- (void)setObject:(nullable id)obj forKeyedSubscript:(id<NSCopying>)key;
+
+/// Returns once every write that returned before this call is applied. Reads already see such
+/// writes, so this is only needed to wait for side effects of applying them, such as removed
+/// objects being released. Returns right away with `GULMutableDictionaryConcurrencyConcurrentReads`.
+- (void)flush;
 
-/// Returns the immutable dictionary.
+/// Returns an immutable snapshot of the objects. The snapshot is copied on the first call after
+/// each write, and later calls return the same snapshot in constant time until the next write.
+/// Compound operations that end up changing nothing keep the snapshot.
 - (NSDictionary *)dictionary;
 
+#pragma mark - Compound operations
+
+// Each of these is applied atomically, with a single synchronization, and before it returns. The
+// blocks they take are called with exclusive access to the dictionary and must not access it.
+
+/// Returns the object for `key`. If there is none, calls `block` and sets the object it returns,
+/// unless it returns nil.
+- (nullable id)objectForKey:(id<NSCopying>)key orInsert:(id _Nullable(NS_NOESCAPE ^)(void))block;
+
+/// Sets `object` for `key`, or removes the object if `object` is nil, if the current object for
+/// `key` is equal to `expectedObject`, where nil expects there to be no object. Returns whether
+/// the object was set.
+- (BOOL)compareAndSetObject:(nullable id)object
+                     forKey:(id<NSCopying>)key
+             expectedObject:(nullable id)expectedObject;
+
+/// Removes the object for `key` if it is equal to `object`. Returns whether it was removed.
+- (BOOL)removeObjectForKey:(id<NSCopying>)key ifEqualTo:(id)object;
+
+/// Calls `updates` with the storage of the dictionary, which it may read and mutate, and must not
+/// keep. Objects it replaces or removes are released only after the dictionary can be accessed
+/// again, so they may access it when they are deallocated.
+- (void)performBatchUpdates:(void(NS_NOESCAPE ^)(NSMutableDictionary *objects))updates;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,366 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerSink.h"
+#import "GoogleUtilities/Tests/Benchmark/Utils/GULBenchmarkUtils.h"
+
+#ifdef DEBUG
+extern void GULResetLogger(void);
+#endif
+
+static NSString *const kSubsystem = @"com.google.utilities.logger.benchmark";
+static NSString *const kCategory = @"[GULLoggerBenchmark]";
+static NSString *const kMessageCode = @"I-BEN000001";
+
+/// The number of calls timed one by one for the latency percentiles.
+static const NSUInteger kLatencySampleCount = 100000;
+
+/// The number of calls each producer thread makes when measuring throughput.
+static const NSUInteger kCallsPerThread = 50000;
+
+/// The number of messages held in a blocked buffer when measuring the heap they allocate and use.
+static const NSUInteger kHeldMessageCount = 1000;
+
+/// The number of times the heap used by queued messages is measured; the median is reported.
+static const NSUInteger kHeldMemoryRounds = 5;
+
+/// Makes one logging call; `i` is the index of the call.
+typedef void (^GULLoggerBenchmarkCall)(NSUInteger i);
+
+static int GULLoggerBenchmarkCompareDoubles(const void *a, const void *b) {
+  double left = *(const double *)a;
+  double right = *(const double *)b;
+  return left < right ? -1 : left > right;
+}
+
+/// Returns the median of `count` values, sorting them in place.
+static double GULLoggerBenchmarkMedian(double *values, NSUInteger count) {
+  qsort(values, count, sizeof(double), GULLoggerBenchmarkCompareDoubles);
+  return values[count / 2];
+}
+
+/// Logs through `GULLoggerWrapper`, which takes a `va_list` like the Swift and weakly linked
+/// callers do.
+static void GULLoggerBenchmarkWrapperLog(GULLoggerLevel level, NSString *message, ...)
+    NS_FORMAT_FUNCTION(2, 3);
+static void GULLoggerBenchmarkWrapperLog(GULLoggerLevel level, NSString *message, ...) {
+  va_list args;
+  va_start(args, message);
+  [GULLoggerWrapper logWithLevel:level
+                       subsystem:kSubsystem
+                        category:kCategory
+                     messageCode:kMessageCode
+                         message:message
+                       arguments:args];
+  va_end(args);
+}
+
+/// Holds up the logger's queue in its first batch until it is released, so that logged messages
+/// stay in their buffers.
+@interface GULLoggerBenchmarkBlockingSink : NSObject <GULLoggerSink>
+@property(nonatomic, readonly) dispatch_semaphore_t entered;
+@property(nonatomic, readonly) dispatch_semaphore_t released;
+@end
+
+@implementation GULLoggerBenchmarkBlockingSink {
+  BOOL _hasBlocked;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _entered = dispatch_semaphore_create(0);
+    _released = dispatch_semaphore_create(0);
+  }
+  return self;
+}
+
+- (void)writeRecords:(NSArray<GULLoggerSinkRecord *> *)records {
+  if (!_hasBlocked) {
+    _hasBlocked = YES;
+    dispatch_semaphore_signal(self.entered);
+    dispatch_semaphore_wait(self.released, DISPATCH_TIME_FOREVER);
+  }
+}
+
+@end
+
+/// Measures the cost of logging calls to the calling thread: latency percentiles of single calls,
+/// messages per second from 1 up to one producer thread per core, the allocations each call makes,
+/// and the heap each queued message holds until it is written. Results are logged with the prefix "GULLogger"; each test also
+/// reports the duration of a fixed batch of calls through `measureBlock:` for XCTest baselines.
+@interface GULLoggerBenchmarkCase : XCTestCase
+
+/// Whether the tests of the class measure debug mode. Defaults to NO.
+@property(class, nonatomic, readonly) BOOL measuresDebugMode;
+
+/// Runs all measurements for one kind of call.
+- (void)measureCall:(NSString *)name call:(GULLoggerBenchmarkCall)call;
+
+@end
+
+@implementation GULLoggerBenchmarkCase
+
++ (BOOL)measuresDebugMode {
+  return NO;
+}
+
+- (void)setUp {
+  [super setUp];
+  GULLoggerFlush();
+#ifdef DEBUG
+  GULResetLogger();
+#endif
+  GULLoggerInitialize();
+  GULSetLoggerLevel(GULLoggerLevelNotice);
+  if ([[self class] measuresDebugMode]) {
+    GULLoggerForceDebug();
+  } else {
+    // Debug mode cannot be left in release builds, where it would make every level logged.
+    XCTSkipIf(GULIsLoggableLevel(GULLoggerLevelInfo),
+              @"Debug mode is on; run the debug mode benchmark on its own.");
+  }
+}
+
+- (void)tearDown {
+  GULLoggerFlush();
+#ifdef DEBUG
+  GULResetLogger();
+#endif
+  [super tearDown];
+}
+
+- (void)measureCall:(NSString *)name call:(GULLoggerBenchmarkCall)call {
+  [self reportLatencyOfCall:name call:call];
+  [self reportThroughputOfCall:name call:call];
+  [self reportHeldMemoryOfCall:name call:call];
+  [self measureBlock:^{
+    @autoreleasepool {
+      for (NSUInteger i = 0; i < kCallsPerThread; i++) {
+        call(i);
+      }
+    }
+    GULLoggerFlush();
+  }];
+}
+
+- (void)reportLatencyOfCall:(NSString *)name call:(GULLoggerBenchmarkCall)call {
+  uint64_t droppedBefore = GULLoggerDroppedRecordCount();
+  uint64_t *samples = calloc(kLatencySampleCount, sizeof(uint64_t));
+  for (NSUInteger i = 0; i < kLatencySampleCount; i++) {
+    // Draining the pool between calls keeps its cost out of the samples.
+    @autoreleasepool {
+      uint64_t start = mach_absolute_time();
+      call(i);
+      samples[i] = mach_absolute_time() - start;
+    }
+  }
+  GULLoggerFlush();
+  GULBenchmarkSortSamples(samples, kLatencySampleCount);
+
+  double (^percentile)(double) = ^double(double fraction) {
+    return GULBenchmarkPercentile(samples, kLatencySampleCount, fraction);
+  };
+  NSLog(@"GULLogger %@ latency: p50 %.0f ns, p90 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, "
+        @"max %.0f ns, %llu dropped",
+        name, percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999),
+        percentile(1), GULLoggerDroppedRecordCount() - droppedBefore);
+  free(samples);
+}
+
+- (void)reportThroughputOfCall:(NSString *)name call:(GULLoggerBenchmarkCall)call {
+  NSUInteger coreCount = [NSProcessInfo processInfo].activeProcessorCount;
+  NSMutableArray<NSNumber *> *threadCounts = [NSMutableArray array];
+  for (NSUInteger threadCount = 1; threadCount < coreCount; threadCount *= 2) {
+    [threadCounts addObject:@(threadCount)];
+  }
+  [threadCounts addObject:@(coreCount)];
+
+  for (NSNumber *threadCountNumber in threadCounts) {
+    NSUInteger threadCount = threadCountNumber.unsignedIntegerValue;
+    uint64_t droppedBefore = GULLoggerDroppedRecordCount();
+    uint64_t startTime = GULBenchmarkRunThreads(threadCount, ^(NSUInteger threadIndex) {
+      for (NSUInteger i = 0; i < kCallsPerThread; i += 256) {
+        @autoreleasepool {
+          for (NSUInteger j = i; j < MIN(i + 256, kCallsPerThread); j++) {
+            call(j);
+          }
+        }
+      }
+    });
+    uint64_t callsDoneTime = mach_absolute_time();
+    GULLoggerFlush();
+    uint64_t drainedTime = mach_absolute_time();
+
+    double messageCount = (double)threadCount * kCallsPerThread;
+    NSLog(@"GULLogger %@ throughput with %2lu threads: %.0f calls/s, %.0f drained/s, "
+          @"%llu dropped",
+          name, (unsigned long)threadCount,
+          messageCount * NSEC_PER_SEC / GULBenchmarkNanoseconds(callsDoneTime - startTime),
+          messageCount * NSEC_PER_SEC / GULBenchmarkNanoseconds(drainedTime - startTime),
+          GULLoggerDroppedRecordCount() - droppedBefore);
+  }
+}
+
+/// Logs `kHeldMessageCount` messages while the logger's queue is blocked, and reports the median
+/// over `kHeldMemoryRounds` of the allocations each call makes, including those freed before it
+/// returns, and of the heap blocks and bytes each message holds until it is written.
+- (void)reportHeldMemoryOfCall:(NSString *)name call:(GULLoggerBenchmarkCall)call {
+  double allocationCounts[kHeldMemoryRounds];
+  double allocatedBytes[kHeldMemoryRounds];
+  double blocks[kHeldMemoryRounds];
+  double bytes[kHeldMemoryRounds];
+  for (NSUInteger round = 0; round < kHeldMemoryRounds; round++) {
+    GULBenchmarkAllocations allocations;
+    malloc_statistics_t held;
+    malloc_statistics_t drained;
+    [self measureHeldMemoryOfCall:call allocations:&allocations held:&held drained:&drained];
+    allocationCounts[round] = (double)allocations.count / kHeldMessageCount;
+    allocatedBytes[round] = (double)allocations.bytes / kHeldMessageCount;
+    blocks[round] = ((double)held.blocks_in_use - drained.blocks_in_use) / kHeldMessageCount;
+    bytes[round] = ((double)held.size_in_use - drained.size_in_use) / kHeldMessageCount;
+  }
+  NSLog(@"GULLogger %@ heap allocated per call: %.2f allocations, %.1f bytes; "
+        @"held per queued message: %.2f blocks, %.1f bytes",
+        name, GULLoggerBenchmarkMedian(allocationCounts, kHeldMemoryRounds),
+        GULLoggerBenchmarkMedian(allocatedBytes, kHeldMemoryRounds),
+        GULLoggerBenchmarkMedian(blocks, kHeldMemoryRounds),
+        GULLoggerBenchmarkMedian(bytes, kHeldMemoryRounds));
+}
+
+/// Stores the allocations made by `kHeldMessageCount` calls in `allocations`, the heap statistics
+/// of the process while their messages are queued behind a blocked sink in `held`, and after they
+/// are written in `drained`. The statistics are taken while no benchmark thread runs and the
+/// logger's queue is idle or blocked, so that their difference is the heap the queued messages
+/// hold, however many zones the process allocates from.
+- (void)measureHeldMemoryOfCall:(GULLoggerBenchmarkCall)call
+                    allocations:(GULBenchmarkAllocations *)allocations
+                           held:(malloc_statistics_t *)held
+                        drained:(malloc_statistics_t *)drained {
+  GULLoggerBenchmarkBlockingSink *sink = [[GULLoggerBenchmarkBlockingSink alloc] init];
+  GULLoggerAddSink(sink);
+  GULOSLogError(kSubsystem, kCategory, YES, kMessageCode, @"Blocking the logger queue.");
+  dispatch_semaphore_wait(sink.entered, DISPATCH_TIME_FOREVER);
+
+  // A new thread gets a buffer with the new capacity, so that no message is dropped. The thread
+  // outlives both measurements, so that its buffer is not freed in between.
+  GULLoggerSetBufferCapacity(kHeldMessageCount * 2);
+  dispatch_semaphore_t logged = dispatch_semaphore_create(0);
+  dispatch_semaphore_t measured = dispatch_semaphore_create(0);
+  NSThread *thread = [[NSThread alloc] initWithBlock:^{
+    // The first call creates the thread's buffer, which is left out of the count. The logger's
+    // queue is blocked, so the allocations counted meanwhile are the calls' own.
+    @autoreleasepool {
+      call(0);
+    }
+    *allocations = GULBenchmarkCountAllocations(^{
+      for (NSUInteger i = 1; i <= kHeldMessageCount; i++) {
+        @autoreleasepool {
+          call(i);
+        }
+      }
+    });
+    dispatch_semaphore_signal(logged);
+    dispatch_semaphore_wait(measured, DISPATCH_TIME_FOREVER);
+  }];
+  [thread start];
+  dispatch_semaphore_wait(logged, DISPATCH_TIME_FOREVER);
+
+  malloc_zone_statistics(NULL, held);
+  dispatch_semaphore_signal(sink.released);
+  GULLoggerFlush();
+  malloc_zone_statistics(NULL, drained);
+
+  dispatch_semaphore_signal(measured);
+  GULLoggerRemoveSink(sink);
+  GULLoggerSetBufferCapacity(256);
+}
+
+@end
+
+/// Compares filtered, logged and forced calls, directly and through `GULLoggerWrapper`. Run it with
+/// `swift test -c release --filter UtilitiesBenchmark.GULLoggerBenchmark`.
+@interface GULLoggerBenchmark : GULLoggerBenchmarkCase
+@end
+
+@implementation GULLoggerBenchmark
+
+- (void)testFilteredLevel {
+  [self measureCall:@"filtered GULOSLogDebug"
+               call:^(NSUInteger i) {
+                 GULOSLogDebug(kSubsystem, kCategory, NO, kMessageCode, @"Message %lu.",
+                               (unsigned long)i);
+               }];
+}
+
+- (void)testFilteredLevelThroughWrapper {
+  [self measureCall:@"filtered GULLoggerWrapper"
+               call:^(NSUInteger i) {
+                 GULLoggerBenchmarkWrapperLog(GULLoggerLevelDebug, @"Message %lu.",
+                                              (unsigned long)i);
+               }];
+}
+
+- (void)testLoggedLevel {
+  [self measureCall:@"logged GULOSLogNotice"
+               call:^(NSUInteger i) {
+                 GULOSLogNotice(kSubsystem, kCategory, NO, kMessageCode, @"Message %lu.",
+                                (unsigned long)i);
+               }];
+}
+
+- (void)testLoggedLevelThroughWrapper {
+  [self measureCall:@"logged GULLoggerWrapper"
+               call:^(NSUInteger i) {
+                 GULLoggerBenchmarkWrapperLog(GULLoggerLevelNotice, @"Message %lu.",
+                                              (unsigned long)i);
+               }];
+}
+
+- (void)testForcedLog {
+  [self measureCall:@"forced GULOSLogDebug"
+               call:^(NSUInteger i) {
+                 GULOSLogDebug(kSubsystem, kCategory, YES, kMessageCode, @"Message %lu.",
+                               (unsigned long)i);
+               }];
+}
+
+@end
+
+/// Measures logging in debug mode, where every level is logged. Debug mode can only be left again
+/// in debug builds, so in release builds `GULLoggerBenchmark` skips its tests once this has run.
+@interface GULLoggerDebugModeBenchmark : GULLoggerBenchmarkCase
+@end
+
+@implementation GULLoggerDebugModeBenchmark
+
++ (BOOL)measuresDebugMode {
+  return YES;
+}
+
+- (void)testDebugMode {
+  [self measureCall:@"debug mode GULOSLogDebug"
+               call:^(NSUInteger i) {
+                 GULOSLogDebug(kSubsystem, kCategory, NO, kMessageCode, @"Message %lu.",
+                               (unsigned long)i);
+               }];
+}
+
+@end
@@ -0,0 +1,88 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibBackend.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+#import "GoogleUtilities/Tests/Benchmark/NSData+zlib/GULNSDataZlibBenchmarkPayload.h"
+
+/// Each measured block processes about this many bytes, so that small payloads are repeated enough
+/// times to be measurable and results are comparable across sizes.
+static const NSUInteger kBytesPerMeasurement = 32 * 1024 * 1024;
+
+/// Compares implementation choices on JSON-like payloads. The size, level and compressibility
+/// matrix is covered by `GULNSDataZlibMatrixBenchmark`.
+@interface GULNSDataZlibBenchmark : XCTestCase
+@end
+
+@implementation GULNSDataZlibBenchmark
+
+/// Measures a gzip and inflate round trip through `backend`.
+- (void)measureBackend:(const GULNSDataZlibBackend *)backend payloadLength:(NSUInteger)length {
+  NSData *payload = GULNSDataZlibBenchmarkPayload(GULNSDataZlibBenchmarkPayloadKindJSON, length);
+  NSUInteger iterations = MAX(kBytesPerMeasurement / length, 1);
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < iterations; i++) {
+      @autoreleasepool {
+        NSData *compressed = backend->gzip(payload, NULL);
+        XCTAssertNotNil(backend->inflate(compressed, NULL));
+      }
+    }
+  }];
+}
+
+- (void)testSerialGzip16MB {
+  NSData *payload =
+      GULNSDataZlibBenchmarkPayload(GULNSDataZlibBenchmarkPayloadKindJSON, 16 * 1024 * 1024);
+  NSUInteger iterations = kBytesPerMeasurement / payload.length;
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < iterations; i++) {
+      @autoreleasepool {
+        XCTAssertNotNil([NSData gul_dataByGzippingData:payload error:NULL]);
+      }
+    }
+  }];
+}
+
+- (void)testConcurrentGzip16MB {
+  NSData *payload =
+      GULNSDataZlibBenchmarkPayload(GULNSDataZlibBenchmarkPayloadKindJSON, 16 * 1024 * 1024);
+  NSUInteger iterations = kBytesPerMeasurement / payload.length;
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < iterations; i++) {
+      @autoreleasepool {
+        XCTAssertNotNil([NSData gul_dataByGzippingData:payload concurrencyThreshold:0 error:NULL]);
+      }
+    }
+  }];
+}
+
+- (void)testZlibBackendRoundTrip64KB {
+  [self measureBackend:&GULNSDataZlibBackendZlib payloadLength:64 * 1024];
+}
+
+- (void)testCompressionBackendRoundTrip64KB {
+  [self measureBackend:&GULNSDataZlibBackendCompression payloadLength:64 * 1024];
+}
+
+- (void)testZlibBackendRoundTrip16MB {
+  [self measureBackend:&GULNSDataZlibBackendZlib payloadLength:16 * 1024 * 1024];
+}
+
+- (void)testCompressionBackendRoundTrip16MB {
+  [self measureBackend:&GULNSDataZlibBackendCompression payloadLength:16 * 1024 * 1024];
+}
+
+@end
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// How compressible a benchmark payload is.
+typedef NS_ENUM(NSInteger, GULNSDataZlibBenchmarkPayloadKind) {
+  /// Uniformly random bytes, which deflate cannot shrink.
+  GULNSDataZlibBenchmarkPayloadKindRandom,
+  /// JSON-like telemetry, which compresses roughly like real uploads.
+  GULNSDataZlibBenchmarkPayloadKindJSON,
+  /// A single short record repeated over and over.
+  GULNSDataZlibBenchmarkPayloadKindRepeated,
+};
+
+/// Returns a short name for `kind`, for benchmark logs.
+FOUNDATION_EXPORT NSString *GULNSDataZlibBenchmarkPayloadKindName(
+    GULNSDataZlibBenchmarkPayloadKind kind);
+
+/// Returns a payload of the given kind and length. The same arguments always return the same bytes.
+FOUNDATION_EXPORT NSData *GULNSDataZlibBenchmarkPayload(GULNSDataZlibBenchmarkPayloadKind kind,
+                                                        NSUInteger length);
+
+NS_ASSUME_NONNULL_END
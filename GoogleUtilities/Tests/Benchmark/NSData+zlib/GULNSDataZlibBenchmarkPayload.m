@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GULNSDataZlibBenchmarkPayload.h"
+
+NSString *GULNSDataZlibBenchmarkPayloadKindName(GULNSDataZlibBenchmarkPayloadKind kind) {
+  switch (kind) {
+    case GULNSDataZlibBenchmarkPayloadKindRandom:
+      return @"random";
+    case GULNSDataZlibBenchmarkPayloadKindJSON:
+      return @"json";
+    case GULNSDataZlibBenchmarkPayloadKindRepeated:
+      return @"repeated";
+  }
+  return @"unknown";
+}
+
+NSData *GULNSDataZlibBenchmarkPayload(GULNSDataZlibBenchmarkPayloadKind kind, NSUInteger length) {
+  NSMutableData *data = [NSMutableData dataWithCapacity:length];
+  switch (kind) {
+    case GULNSDataZlibBenchmarkPayloadKindRandom: {
+      // A fixed-seed xorshift generator keeps runs comparable.
+      data.length = length;
+      unsigned char *bytes = data.mutableBytes;
+      uint64_t state = 0x9e3779b97f4a7c15ULL;
+      for (NSUInteger i = 0; i < length; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        bytes[i] = (unsigned char)state;
+      }
+      break;
+    }
+    case GULNSDataZlibBenchmarkPayloadKindJSON: {
+      NSUInteger event = 0;
+      while (data.length < length) {
+        NSString *record = [NSString
+            stringWithFormat:
+                @"{\"event\":\"screen_view\",\"id\":%lu,\"ts\":%lu,\"params\":{\"a\":%lu}},",
+                (unsigned long)event, (unsigned long)(1700000000000 + event * 37),
+                (unsigned long)(event * 7919 % 1000)];
+        [data appendData:[record dataUsingEncoding:NSUTF8StringEncoding]];
+        event++;
+      }
+      break;
+    }
+    case GULNSDataZlibBenchmarkPayloadKindRepeated: {
+      NSData *record = [@"{\"event\":\"heartbeat\",\"status\":\"ok\"}\n"
+          dataUsingEncoding:NSUTF8StringEncoding];
+      while (data.length < length) {
+        [data appendData:record];
+      }
+      break;
+    }
+  }
+  data.length = length;
+  return data;
+}
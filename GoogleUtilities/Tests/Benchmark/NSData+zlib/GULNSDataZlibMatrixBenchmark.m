@@ -0,0 +1,157 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <mach/mach_time.h>
+
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+#import "GoogleUtilities/Tests/Benchmark/NSData+zlib/GULNSDataZlibBenchmarkPayload.h"
+#import "GoogleUtilities/Tests/Benchmark/Utils/GULBenchmarkUtils.h"
+
+/// Each cell of the matrix processes about this many uncompressed bytes per measurement.
+static const NSUInteger kBytesPerCell = 8 * 1024 * 1024;
+
+/// Measures deflate and inflate over a matrix of payload sizes, compression levels and kinds of
+/// payload. Each test reports wall clock, CPU and peak memory through XCTest metrics, and logs the
+/// throughput of every cell in MB/s of uncompressed data along with the heap allocations each
+/// operation makes. Run it headless with
+/// `swift test -c release --filter UtilitiesBenchmark.GULNSDataZlibMatrixBenchmark`.
+@interface GULNSDataZlibMatrixBenchmark : XCTestCase
+@end
+
+@implementation GULNSDataZlibMatrixBenchmark
+
++ (NSArray<NSNumber *> *)payloadLengths {
+  return @[ @(1024), @(64 * 1024), @(1024 * 1024), @(16 * 1024 * 1024) ];
+}
+
++ (NSArray<NSNumber *> *)levels {
+  return @[ @1, @6, @9 ];
+}
+
+/// Runs `operation` over every size and level of `kind`, then logs the throughput of each cell and
+/// the allocations of one more pass over it, counted outside the timed runs.
+/// `operation` is handed the payload and its gzipped form at the cell's level, and returns whether
+/// it succeeded.
+- (void)measureOperation:(NSString *)name
+                    kind:(GULNSDataZlibBenchmarkPayloadKind)kind
+                   block:(BOOL (^)(NSData *payload,
+                                   NSData *compressed,
+                                   GULNSDataZlibOptions *options))operation {
+  NSMutableArray<NSDictionary *> *cells = [NSMutableArray array];
+  for (NSNumber *length in [[self class] payloadLengths]) {
+    NSData *payload = GULNSDataZlibBenchmarkPayload(kind, length.unsignedIntegerValue);
+    for (NSNumber *level in [[self class] levels]) {
+      GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+      options.level = level.integerValue;
+      NSData *compressed = [NSData gul_dataByDeflatingData:payload options:options error:NULL];
+      [cells addObject:@{
+        @"payload" : payload,
+        @"compressed" : compressed,
+        @"options" : options,
+        @"iterations" : @(MAX(kBytesPerCell / payload.length, 1)),
+      }];
+    }
+  }
+
+  uint64_t *elapsed = calloc(cells.count, sizeof(uint64_t));
+  __block NSUInteger runs = 0;
+  void (^measuredBlock)(void) = ^{
+    [cells enumerateObjectsUsingBlock:^(NSDictionary *cell, NSUInteger index, BOOL *stop) {
+      NSUInteger iterations = [cell[@"iterations"] unsignedIntegerValue];
+      uint64_t start = mach_absolute_time();
+      for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+          XCTAssertTrue(operation(cell[@"payload"], cell[@"compressed"], cell[@"options"]));
+        }
+      }
+      elapsed[index] += mach_absolute_time() - start;
+    }];
+    runs++;
+  };
+  if (@available(iOS 13.0, tvOS 13.0, macOS 10.15, *)) {
+    [self measureWithMetrics:@[
+      [[XCTClockMetric alloc] init], [[XCTCPUMetric alloc] init], [[XCTMemoryMetric alloc] init]
+    ]
+                       block:measuredBlock];
+  } else {
+    [self measureBlock:measuredBlock];
+  }
+
+  [cells enumerateObjectsUsingBlock:^(NSDictionary *cell, NSUInteger index, BOOL *stop) {
+    NSData *payload = cell[@"payload"];
+    NSData *compressed = cell[@"compressed"];
+    NSUInteger iterations = [cell[@"iterations"] unsignedIntegerValue];
+    GULBenchmarkAllocations allocations = GULBenchmarkCountAllocations(^{
+      for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+          operation(payload, compressed, cell[@"options"]);
+        }
+      }
+    });
+    double seconds = GULBenchmarkNanoseconds(elapsed[index]) / NSEC_PER_SEC;
+    double megabytes = (double)payload.length * iterations * runs / (1024 * 1024);
+    NSLog(@"GULNSDataZlib %@ %@ %8lu bytes level %ld: %8.1f MB/s, ratio %.3f, "
+          @"%.1f allocations and %.0f bytes allocated per operation",
+          name, GULNSDataZlibBenchmarkPayloadKindName(kind), (unsigned long)payload.length,
+          (long)[cell[@"options"] level], megabytes / seconds,
+          (double)compressed.length / payload.length, (double)allocations.count / iterations,
+          (double)allocations.bytes / iterations);
+  }];
+  free(elapsed);
+}
+
+- (void)measureDeflateWithKind:(GULNSDataZlibBenchmarkPayloadKind)kind {
+  [self measureOperation:@"deflate"
+                    kind:kind
+                   block:^BOOL(NSData *payload, NSData *compressed, GULNSDataZlibOptions *options) {
+                     return [NSData gul_dataByDeflatingData:payload options:options error:NULL] !=
+                            nil;
+                   }];
+}
+
+- (void)measureInflateWithKind:(GULNSDataZlibBenchmarkPayloadKind)kind {
+  [self measureOperation:@"inflate"
+                    kind:kind
+                   block:^BOOL(NSData *payload, NSData *compressed, GULNSDataZlibOptions *options) {
+                     return [NSData gul_dataByInflatingGzippedData:compressed error:NULL] != nil;
+                   }];
+}
+
+- (void)testDeflateRandom {
+  [self measureDeflateWithKind:GULNSDataZlibBenchmarkPayloadKindRandom];
+}
+
+- (void)testDeflateJSON {
+  [self measureDeflateWithKind:GULNSDataZlibBenchmarkPayloadKindJSON];
+}
+
+- (void)testDeflateRepeated {
+  [self measureDeflateWithKind:GULNSDataZlibBenchmarkPayloadKindRepeated];
+}
+
+- (void)testInflateRandom {
+  [self measureInflateWithKind:GULNSDataZlibBenchmarkPayloadKindRandom];
+}
+
+- (void)testInflateJSON {
+  [self measureInflateWithKind:GULNSDataZlibBenchmarkPayloadKindJSON];
+}
+
+- (void)testInflateRepeated {
+  [self measureInflateWithKind:GULNSDataZlibBenchmarkPayloadKindRepeated];
+}
+
+@end
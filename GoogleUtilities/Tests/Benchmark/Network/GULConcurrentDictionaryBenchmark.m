@@ -0,0 +1,119 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <mach/mach_time.h>
+
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULConcurrentDictionary.h"
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULMutableDictionary.h"
+#import "GoogleUtilities/Tests/Benchmark/Utils/GULBenchmarkUtils.h"
+
+/// The number of writes each thread makes.
+static const NSUInteger kWritesPerThread = 100000;
+
+/// The number of distinct keys each thread writes.
+static const NSUInteger kKeysPerThread = 1024;
+
+/// The most writer threads measured.
+static const NSUInteger kMaximumThreadCount = 16;
+
+/// Measures how write throughput scales from 1 to 16 threads for `GULConcurrentDictionary` and
+/// both modes of `GULMutableDictionary`. Each thread sets and removes keys of its own, so threads
+/// only contend on the dictionary's synchronization. Results are logged with the prefix
+/// "GULConcurrentDictionary". Run it with
+/// `swift test -c release --filter UtilitiesBenchmark.GULConcurrentDictionaryBenchmark`.
+@interface GULConcurrentDictionaryBenchmark : XCTestCase
+@end
+
+@implementation GULConcurrentDictionaryBenchmark
+
+- (void)testConcurrentDictionaryWrites {
+  [self reportWriteScalingOf:[[GULConcurrentDictionary alloc] init]
+                        name:@"GULConcurrentDictionary"];
+}
+
+- (void)testConcurrentReadsMutableDictionaryWrites {
+  [self reportWriteScalingOf:[[GULMutableDictionary alloc]
+                                 initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads]
+                        name:@"GULMutableDictionary (concurrent reads)"];
+}
+
+- (void)testSerialMutableDictionaryWrites {
+  [self reportWriteScalingOf:[[GULMutableDictionary alloc] init]
+                        name:@"GULMutableDictionary (serial)"];
+}
+
+/// Returns the keys of each thread, created up front so that their allocation is not measured.
+- (NSArray<NSArray<NSNumber *> *> *)keys {
+  NSMutableArray<NSArray<NSNumber *> *> *keys = [NSMutableArray array];
+  for (NSUInteger thread = 0; thread < kMaximumThreadCount; thread++) {
+    NSMutableArray<NSNumber *> *threadKeys = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kKeysPerThread; i++) {
+      [threadKeys addObject:@(thread * kKeysPerThread + i)];
+    }
+    [keys addObject:threadKeys];
+  }
+  return keys;
+}
+
+/// Logs the writes per second to `dictionary`, a `GULConcurrentDictionary` or a
+/// `GULMutableDictionary`, of 1, 2, 4, 8 and 16 threads, and reports the duration of the 16 thread
+/// run through `measureBlock:`.
+- (void)reportWriteScalingOf:(id)dictionary name:(NSString *)name {
+  NSArray<NSArray<NSNumber *> *> *keys = [self keys];
+  double singleThreadThroughput = 0;
+  for (NSUInteger threadCount = 1; threadCount <= kMaximumThreadCount; threadCount *= 2) {
+    uint64_t duration = [self durationOfWritesTo:dictionary keys:keys threadCount:threadCount];
+    double throughput =
+        threadCount * kWritesPerThread * NSEC_PER_SEC / GULBenchmarkNanoseconds(duration);
+    if (threadCount == 1) {
+      singleThreadThroughput = throughput;
+    }
+    NSLog(@"GULConcurrentDictionary %@ writes with %2lu threads: %.0f writes/s, %.2fx one thread",
+          name, (unsigned long)threadCount, throughput, throughput / singleThreadThroughput);
+  }
+
+  [self measureBlock:^{
+    [self durationOfWritesTo:dictionary keys:keys threadCount:kMaximumThreadCount];
+  }];
+}
+
+/// Starts `threadCount` threads together, each of which alternately sets and removes its keys, and
+/// returns the mach time until all their writes are applied.
+- (uint64_t)durationOfWritesTo:(id)dictionary
+                          keys:(NSArray<NSArray<NSNumber *> *> *)keys
+                   threadCount:(NSUInteger)threadCount {
+  uint64_t startTime = GULBenchmarkRunThreads(threadCount, ^(NSUInteger threadIndex) {
+    NSArray<NSNumber *> *threadKeys = keys[threadIndex];
+    for (NSUInteger i = 0; i < kWritesPerThread; i += 256) {
+      @autoreleasepool {
+        for (NSUInteger j = i; j < MIN(i + 256, kWritesPerThread); j++) {
+          NSNumber *key = threadKeys[j % kKeysPerThread];
+          if (j & 1) {
+            [dictionary removeObjectForKey:key];
+          } else {
+            dictionary[key] = key;
+          }
+        }
+      }
+    }
+  });
+  // Writes to a serial `GULMutableDictionary` are asynchronous; reading waits until they are
+  // applied.
+  [dictionary count];
+  return mach_absolute_time() - startTime;
+}
+
+@end
@@ -0,0 +1,266 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <mach/mach_time.h>
+#import <stdlib.h>
+
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULConcurrentDictionary.h"
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULMutableDictionary.h"
+#import "GoogleUtilities/Tests/Benchmark/Utils/GULBenchmarkUtils.h"
+
+/// The percentages of operations that are reads, unless set with a comma-separated list in the
+/// `GUL_DICTIONARY_BENCHMARK_READ_PERCENTAGES` environment variable.
+static NSString *const kDefaultReadPercentages = @"99,90,50";
+
+/// The numbers of distinct keys, unless set in `GUL_DICTIONARY_BENCHMARK_KEY_COUNTS`.
+static NSString *const kDefaultKeyCounts = @"16,1024,65536";
+
+/// The numbers of threads, unless set in `GUL_DICTIONARY_BENCHMARK_THREAD_COUNTS`.
+static NSString *const kDefaultThreadCounts = @"1,4,16";
+
+/// The operations each thread makes, unless set in `GUL_DICTIONARY_BENCHMARK_OPERATIONS`.
+static const NSUInteger kDefaultOperationsPerThread = 50000;
+
+typedef NS_ENUM(uint32_t, GULDictionaryBenchmarkOperationKind) {
+  GULDictionaryBenchmarkOperationKindRead,
+  GULDictionaryBenchmarkOperationKindSet,
+  GULDictionaryBenchmarkOperationKindRemove,
+};
+
+/// An operation of a thread on the key at `keyIndex`.
+typedef struct {
+  uint32_t keyIndex;
+  GULDictionaryBenchmarkOperationKind kind;
+} GULDictionaryBenchmarkOperation;
+
+/// Returns the positive integers in the comma-separated `value`.
+static NSArray<NSNumber *> *GULDictionaryBenchmarkParseIntegers(NSString *value) {
+  NSMutableArray<NSNumber *> *integers = [NSMutableArray array];
+  for (NSString *component in [value componentsSeparatedByString:@","]) {
+    NSInteger integer = component.integerValue;
+    if (integer > 0) {
+      [integers addObject:@(integer)];
+    }
+  }
+  return integers;
+}
+
+/// Returns the positive integers in the comma-separated environment variable `name`, or in
+/// `defaultValue` if it is not set or has none.
+static NSArray<NSNumber *> *GULDictionaryBenchmarkIntegers(NSString *name, NSString *defaultValue) {
+  NSString *value = [NSProcessInfo processInfo].environment[name];
+  NSArray<NSNumber *> *integers = value ? GULDictionaryBenchmarkParseIntegers(value) : @[];
+  return integers.count > 0 ? integers : GULDictionaryBenchmarkParseIntegers(defaultValue);
+}
+
+/// Measures `GULMutableDictionary` in both modes and `GULConcurrentDictionary` under contention,
+/// for every combination of read percentage, key count and thread count. Each thread makes a
+/// pregenerated random sequence of reads, sets and removes, half of the writes each, on a
+/// dictionary that starts out with every other key. Logs operations per second, from the start
+/// until all writes are applied, and latency percentiles of single operations, with the prefix
+/// "GULDictionaryContention". Writes to a serial `GULMutableDictionary` return before they are
+/// applied, so their latency is that of queuing them.
+///
+/// The matrix is configured with the environment variables documented above, e.g.
+/// `GUL_DICTIONARY_BENCHMARK_THREAD_COUNTS=1,2,4,8 swift test -c release
+/// --filter UtilitiesBenchmark.GULDictionaryContentionBenchmark`.
+@interface GULDictionaryContentionBenchmark : XCTestCase
+@end
+
+@implementation GULDictionaryContentionBenchmark
+
+- (void)testSerialMutableDictionary {
+  [self measureDictionaryNamed:@"GULMutableDictionary (serial)"
+                       factory:^id {
+                         return [[GULMutableDictionary alloc] init];
+                       }];
+}
+
+- (void)testConcurrentReadsMutableDictionary {
+  [self measureDictionaryNamed:@"GULMutableDictionary (concurrent reads)"
+                       factory:^id {
+                         return [[GULMutableDictionary alloc]
+                             initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
+                       }];
+}
+
+- (void)testConcurrentDictionary {
+  [self measureDictionaryNamed:@"GULConcurrentDictionary"
+                       factory:^id {
+                         return [[GULConcurrentDictionary alloc] init];
+                       }];
+}
+
+/// Logs the results of every cell of the matrix for dictionaries made by `factory`, and reports
+/// the duration of the last cell through `measureBlock:`.
+- (void)measureDictionaryNamed:(NSString *)name factory:(id (^)(void))factory {
+  NSDictionary<NSString *, NSString *> *environment = [NSProcessInfo processInfo].environment;
+  NSArray<NSNumber *> *readPercentages = GULDictionaryBenchmarkIntegers(
+      @"GUL_DICTIONARY_BENCHMARK_READ_PERCENTAGES", kDefaultReadPercentages);
+  NSArray<NSNumber *> *keyCounts =
+      GULDictionaryBenchmarkIntegers(@"GUL_DICTIONARY_BENCHMARK_KEY_COUNTS", kDefaultKeyCounts);
+  NSArray<NSNumber *> *threadCounts = GULDictionaryBenchmarkIntegers(
+      @"GUL_DICTIONARY_BENCHMARK_THREAD_COUNTS", kDefaultThreadCounts);
+  NSInteger operations = environment[@"GUL_DICTIONARY_BENCHMARK_OPERATIONS"].integerValue;
+  NSUInteger operationsPerThread =
+      operations > 0 ? (NSUInteger)operations : kDefaultOperationsPerThread;
+
+  for (NSNumber *readPercentage in readPercentages) {
+    for (NSNumber *keyCount in keyCounts) {
+      NSArray<NSNumber *> *keys = [self keysWithCount:keyCount.unsignedIntegerValue];
+      for (NSNumber *threadCount in threadCounts) {
+        NSData *operations = [self operationsWithThreadCount:threadCount.unsignedIntegerValue
+                                         operationsPerThread:operationsPerThread
+                                              readPercentage:readPercentage.unsignedIntegerValue
+                                                    keyCount:keyCount.unsignedIntegerValue];
+        [self reportOperations:operations
+                   threadCount:threadCount.unsignedIntegerValue
+                    dictionary:[self populatedDictionary:factory() keys:keys]
+                          keys:keys
+                   description:[NSString stringWithFormat:@"%@ reads %2lu%% keys %6lu threads %2lu",
+                                                          name, readPercentage.unsignedLongValue,
+                                                          keyCount.unsignedLongValue,
+                                                          threadCount.unsignedLongValue]];
+      }
+    }
+  }
+
+  NSArray<NSNumber *> *keys = [self keysWithCount:keyCounts.lastObject.unsignedIntegerValue];
+  NSUInteger threadCount = threadCounts.lastObject.unsignedIntegerValue;
+  NSUInteger readPercentage = readPercentages.lastObject.unsignedIntegerValue;
+  NSData *operations = [self operationsWithThreadCount:threadCount
+                                   operationsPerThread:operationsPerThread
+                                        readPercentage:readPercentage
+                                              keyCount:keys.count];
+  [self measureBlock:^{
+    [self runOperations:operations
+            threadCount:threadCount
+             dictionary:[self populatedDictionary:factory() keys:keys]
+                   keys:keys
+                samples:NULL];
+  }];
+}
+
+- (NSArray<NSNumber *> *)keysWithCount:(NSUInteger)keyCount {
+  NSMutableArray<NSNumber *> *keys = [NSMutableArray arrayWithCapacity:keyCount];
+  for (NSUInteger i = 0; i < keyCount; i++) {
+    [keys addObject:@(i)];
+  }
+  return keys;
+}
+
+- (id)populatedDictionary:(id)dictionary keys:(NSArray<NSNumber *> *)keys {
+  for (NSUInteger i = 0; i < keys.count; i += 2) {
+    dictionary[keys[i]] = keys[i];
+  }
+  [dictionary count];
+  return dictionary;
+}
+
+/// Returns `threadCount` consecutive sequences of `operationsPerThread` random operations, made
+/// up front so that generating them is not measured.
+- (NSData *)operationsWithThreadCount:(NSUInteger)threadCount
+                  operationsPerThread:(NSUInteger)operationsPerThread
+                       readPercentage:(NSUInteger)readPercentage
+                             keyCount:(NSUInteger)keyCount {
+  NSUInteger operationCount = threadCount * operationsPerThread;
+  NSMutableData *data =
+      [NSMutableData dataWithLength:operationCount * sizeof(GULDictionaryBenchmarkOperation)];
+  GULDictionaryBenchmarkOperation *operations = data.mutableBytes;
+  for (NSUInteger i = 0; i < operationCount; i++) {
+    operations[i].keyIndex = arc4random_uniform((uint32_t)keyCount);
+    uint32_t roll = arc4random_uniform(200);
+    if (roll < readPercentage * 2) {
+      operations[i].kind = GULDictionaryBenchmarkOperationKindRead;
+    } else if (roll & 1) {
+      operations[i].kind = GULDictionaryBenchmarkOperationKindSet;
+    } else {
+      operations[i].kind = GULDictionaryBenchmarkOperationKindRemove;
+    }
+  }
+  return data;
+}
+
+/// Runs `operations` and logs their throughput and latency percentiles.
+- (void)reportOperations:(NSData *)operations
+             threadCount:(NSUInteger)threadCount
+              dictionary:(id)dictionary
+                    keys:(NSArray<NSNumber *> *)keys
+             description:(NSString *)description {
+  NSUInteger operationCount = operations.length / sizeof(GULDictionaryBenchmarkOperation);
+  uint64_t *samples = calloc(operationCount, sizeof(uint64_t));
+  uint64_t duration = [self runOperations:operations
+                              threadCount:threadCount
+                               dictionary:dictionary
+                                     keys:keys
+                                  samples:samples];
+  GULBenchmarkSortSamples(samples, operationCount);
+
+  double (^percentile)(double) = ^double(double fraction) {
+    return GULBenchmarkPercentile(samples, operationCount, fraction);
+  };
+  NSLog(@"GULDictionaryContention %@: %.0f ops/s, p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, "
+        @"max %.0f ns",
+        description, operationCount * NSEC_PER_SEC / GULBenchmarkNanoseconds(duration),
+        percentile(0.5), percentile(0.99), percentile(0.999), percentile(1));
+  free(samples);
+}
+
+/// Starts `threadCount` threads together, each running its share of `operations`, and returns the
+/// mach time until all writes are applied. Stores the mach time of each operation in `samples`,
+/// unless it is NULL.
+- (uint64_t)runOperations:(NSData *)operations
+              threadCount:(NSUInteger)threadCount
+               dictionary:(id)dictionary
+                     keys:(NSArray<NSNumber *> *)keys
+                  samples:(uint64_t *)samples {
+  NSUInteger operationsPerThread =
+      operations.length / sizeof(GULDictionaryBenchmarkOperation) / threadCount;
+  uint64_t startTime = GULBenchmarkRunThreads(threadCount, ^(NSUInteger threadIndex) {
+    const GULDictionaryBenchmarkOperation *threadOperations =
+        (const GULDictionaryBenchmarkOperation *)operations.bytes +
+        threadIndex * operationsPerThread;
+    uint64_t *threadSamples = samples ? samples + threadIndex * operationsPerThread : NULL;
+    for (NSUInteger i = 0; i < operationsPerThread; i += 256) {
+      @autoreleasepool {
+        for (NSUInteger j = i; j < MIN(i + 256, operationsPerThread); j++) {
+          NSNumber *key = keys[threadOperations[j].keyIndex];
+          uint64_t operationStart = threadSamples ? mach_absolute_time() : 0;
+          switch (threadOperations[j].kind) {
+            case GULDictionaryBenchmarkOperationKindRead:
+              [dictionary objectForKey:key];
+              break;
+            case GULDictionaryBenchmarkOperationKindSet:
+              dictionary[key] = key;
+              break;
+            case GULDictionaryBenchmarkOperationKindRemove:
+              [dictionary removeObjectForKey:key];
+              break;
+          }
+          if (threadSamples) {
+            threadSamples[j] = mach_absolute_time() - operationStart;
+          }
+        }
+      }
+    }
+  });
+  // Writes to a serial `GULMutableDictionary` are asynchronous; reading waits until they are
+  // applied.
+  [dictionary count];
+  return mach_absolute_time() - startTime;
+}
+
+@end
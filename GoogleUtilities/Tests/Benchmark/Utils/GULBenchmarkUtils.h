@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Converts a difference of `mach_absolute_time()` values to nanoseconds.
+FOUNDATION_EXPORT double GULBenchmarkNanoseconds(uint64_t machTime);
+
+/// Starts `threadCount` threads, waits until all of them are running, then lets them run `body`
+/// together, passing each its index. Returns once every thread has finished, with the
+/// `mach_absolute_time()` at which they were let go, so that thread creation is not measured.
+FOUNDATION_EXPORT uint64_t GULBenchmarkRunThreads(NSUInteger threadCount,
+                                                  void (^body)(NSUInteger threadIndex));
+
+/// Sorts `count` mach time samples in place, for `GULBenchmarkPercentile`.
+FOUNDATION_EXPORT void GULBenchmarkSortSamples(uint64_t *samples, NSUInteger count);
+
+/// Returns the sample at `fraction` of the sorted `samples`, in nanoseconds; 1 returns the
+/// largest. `count` must not be 0.
+FOUNDATION_EXPORT double GULBenchmarkPercentile(const uint64_t *samples,
+                                                NSUInteger count,
+                                                double fraction);
+
+/// Heap allocations counted by `GULBenchmarkCountAllocations`.
+typedef struct {
+  /// The number of malloc, calloc, realloc and similar calls.
+  uint64_t count;
+  /// The bytes requested by those calls; realloc counts its new size.
+  uint64_t bytes;
+} GULBenchmarkAllocations;
+
+/// Runs `block` and returns the heap allocations made by every thread of the process meanwhile,
+/// counted through the `malloc_logger` hook that malloc calls for every allocation. Frees are not
+/// subtracted. Calls must not overlap.
+FOUNDATION_EXPORT GULBenchmarkAllocations GULBenchmarkCountAllocations(void (^block)(void));
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleUtilities/Tests/Benchmark/Utils/GULBenchmarkUtils.h"
+
+#import <mach/mach_time.h>
+#import <stdlib.h>
+
+/// The hook malloc calls for every allocation and free while it is set, as Instruments and
+/// MallocStackLogging do. Exported by libmalloc but not declared in its public headers.
+typedef void(GULBenchmarkMallocLogger)(uint32_t type,
+                                       uintptr_t arg1,
+                                       uintptr_t arg2,
+                                       uintptr_t arg3,
+                                       uintptr_t result,
+                                       uint32_t numHotFramesToSkip);
+extern GULBenchmarkMallocLogger *malloc_logger;
+
+/// The `type` flags of `malloc_logger` calls, from libmalloc.
+enum {
+  kGULBenchmarkMallocLogAllocate = 2,
+  kGULBenchmarkMallocLogDeallocate = 4,
+};
+
+double GULBenchmarkNanoseconds(uint64_t machTime) {
+  static mach_timebase_info_data_t timebase;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    mach_timebase_info(&timebase);
+  });
+  return (double)machTime * timebase.numer / timebase.denom;
+}
+
+uint64_t GULBenchmarkRunThreads(NSUInteger threadCount, void (^body)(NSUInteger threadIndex)) {
+  dispatch_group_t ready = dispatch_group_create();
+  dispatch_group_t finished = dispatch_group_create();
+  dispatch_semaphore_t start = dispatch_semaphore_create(0);
+  for (NSUInteger t = 0; t < threadCount; t++) {
+    dispatch_group_enter(ready);
+    dispatch_group_enter(finished);
+    NSThread *thread = [[NSThread alloc] initWithBlock:^{
+      dispatch_group_leave(ready);
+      dispatch_semaphore_wait(start, DISPATCH_TIME_FOREVER);
+      body(t);
+      dispatch_group_leave(finished);
+    }];
+    [thread start];
+  }
+  dispatch_group_wait(ready, DISPATCH_TIME_FOREVER);
+
+  uint64_t startTime = mach_absolute_time();
+  for (NSUInteger t = 0; t < threadCount; t++) {
+    dispatch_semaphore_signal(start);
+  }
+  dispatch_group_wait(finished, DISPATCH_TIME_FOREVER);
+  return startTime;
+}
+
+static int GULBenchmarkCompareSamples(const void *a, const void *b) {
+  uint64_t left = *(const uint64_t *)a;
+  uint64_t right = *(const uint64_t *)b;
+  return left < right ? -1 : left > right;
+}
+
+void GULBenchmarkSortSamples(uint64_t *samples, NSUInteger count) {
+  qsort(samples, count, sizeof(uint64_t), GULBenchmarkCompareSamples);
+}
+
+double GULBenchmarkPercentile(const uint64_t *samples, NSUInteger count, double fraction) {
+  NSUInteger index = MIN((NSUInteger)(fraction * count), count - 1);
+  return GULBenchmarkNanoseconds(samples[index]);
+}
+
+/// The logger that was set before counting started, such as MallocStackLogging's, which is still
+/// called.
+static GULBenchmarkMallocLogger *sGULBenchmarkPreviousMallocLogger;
+
+static GULBenchmarkAllocations sGULBenchmarkAllocations;
+
+/// Counts an allocation. Runs inside malloc, so it must not allocate.
+static void GULBenchmarkCountAllocation(uint32_t type,
+                                        uintptr_t arg1,
+                                        uintptr_t arg2,
+                                        uintptr_t arg3,
+                                        uintptr_t result,
+                                        uint32_t numHotFramesToSkip) {
+  if (type & kGULBenchmarkMallocLogAllocate) {
+    // realloc is logged as a free and an allocation at once, with the new size in `arg3`.
+    uintptr_t size = (type & kGULBenchmarkMallocLogDeallocate) ? arg3 : arg2;
+    __atomic_fetch_add(&sGULBenchmarkAllocations.count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&sGULBenchmarkAllocations.bytes, size, __ATOMIC_RELAXED);
+  }
+  if (sGULBenchmarkPreviousMallocLogger) {
+    sGULBenchmarkPreviousMallocLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+  }
+}
+
+GULBenchmarkAllocations GULBenchmarkCountAllocations(void (^block)(void)) {
+  sGULBenchmarkAllocations = (GULBenchmarkAllocations){0};
+  sGULBenchmarkPreviousMallocLogger = malloc_logger;
+  __atomic_store_n(&malloc_logger, GULBenchmarkCountAllocation, __ATOMIC_SEQ_CST);
+  block();
+  __atomic_store_n(&malloc_logger, sGULBenchmarkPreviousMallocLogger, __ATOMIC_SEQ_CST);
+  GULBenchmarkAllocations allocations;
+  allocations.count = __atomic_load_n(&sGULBenchmarkAllocations.count, __ATOMIC_RELAXED);
+  allocations.bytes = __atomic_load_n(&sGULBenchmarkAllocations.bytes, __ATOMIC_RELAXED);
+  return allocations;
+}
@@ -0,0 +1,137 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerFields.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerFileSink.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerSink.h"
+#import "GoogleUtilities/Tests/Unit/Logger/GULLoggerTestSink.h"
+
+@interface GULLoggerFieldsTest : XCTestCase
+@property(nonatomic) GULLoggerHandle *handle;
+@property(nonatomic) GULLoggerTestSink *sink;
+@property(nonatomic) NSInteger evaluationCount;
+@end
+
+@implementation GULLoggerFieldsTest
+
+- (void)setUp {
+  [super setUp];
+  GULLoggerFlush();
+  self.handle =
+      GULLoggerRegisterHandle(@"com.google.utilities.logger.test", @"[GULLoggerFieldsTest]");
+  self.sink = [[GULLoggerTestSink alloc] init];
+  GULLoggerAddSink(self.sink);
+}
+
+- (void)tearDown {
+  GULLoggerRemoveSink(self.sink);
+  [super tearDown];
+}
+
+- (int64_t)evaluatedValue {
+  self.evaluationCount++;
+  return 1;
+}
+
+- (void)testFieldsReachSinks {
+  NSError *error = [NSError errorWithDomain:@"GULTestDomain" code:42 userInfo:nil];
+  NSMutableString *path = [NSMutableString stringWithString:@"/v1/items"];
+  GUL_LOG_FIELDS(self.handle, GULLoggerLevelError, NO, @"I-TST000001", @"Request failed.",
+                 GULLoggerFieldInt64("status", 503), GULLoggerFieldDouble("seconds", 1.5),
+                 GULLoggerFieldStaticString("method", "GET"), GULLoggerFieldString("path", path),
+                 GULLoggerFieldString("etag", nil), GULLoggerFieldError("error", error));
+  // The string was copied when it was logged.
+  [path appendString:@"/changed"];
+  GULLoggerFlush();
+
+  XCTAssertEqual(self.sink.records.count, 1);
+  GULLoggerSinkRecord *record = self.sink.records.firstObject;
+  XCTAssertEqualObjects(record.message, @"Request failed.");
+  NSDictionary *expectedFields = @{
+    @"status" : @503,
+    @"seconds" : @1.5,
+    @"method" : @"GET",
+    @"path" : @"/v1/items",
+    @"etag" : [NSNull null],
+    @"error" : error,
+  };
+  XCTAssertEqualObjects(record.fields, expectedFields);
+  XCTAssertTrue([record.description hasSuffix:@"Request failed. error=GULTestDomain:42 "
+                                              @"etag=null method=\"GET\" path=\"/v1/items\" "
+                                              @"seconds=1.5 status=503"]);
+}
+
+- (void)testFieldsAreNotCreatedForMessagesNotLogged {
+  GUL_LOG_FIELDS(self.handle, GULLoggerLevelDebug, NO, @"I-TST000001", @"Not logged.",
+                 GULLoggerFieldInt64("value", [self evaluatedValue]));
+  XCTAssertEqual(self.evaluationCount, 0);
+
+  GUL_LOG_FIELDS(self.handle, GULLoggerLevelDebug, YES, @"I-TST000001", @"Forced.",
+                 GULLoggerFieldInt64("value", [self evaluatedValue]));
+  XCTAssertEqual(self.evaluationCount, 1);
+}
+
+- (void)testFieldObjectsAreReleasedWhenNotLogged {
+  __weak NSError *weakError;
+  @autoreleasepool {
+    NSError *error = [NSError errorWithDomain:@"GULTestDomain" code:1 userInfo:nil];
+    weakError = error;
+    GULLoggerField field = GULLoggerFieldError("error", error);
+    GULLoggerLogFields(self.handle, GULLoggerLevelDebug, NO, @"I-TST000001", @"Not logged.",
+                       &field, 1);
+  }
+  XCTAssertNil(weakError);
+}
+
+- (void)testFileSinkKeepsFields {
+  NSString *directory =
+      [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+  GULLoggerFileSink *fileSink = [[GULLoggerFileSink alloc] initWithDirectory:directory
+                                                             maximumFileSize:0
+                                                            maximumFileCount:1
+                                                                       error:NULL];
+  NSDictionary *fields = @{
+    @"status" : @503,
+    @"seconds" : @1.5,
+    @"path" : @"/v1/items",
+    @"etag" : [NSNull null],
+    @"error" : [NSError errorWithDomain:@"GULTestDomain"
+                                   code:-7
+                               userInfo:@{NSLocalizedDescriptionKey : @"Failed."}],
+  };
+  [fileSink writeRecords:@[ [[GULLoggerSinkRecord alloc] initWithLevel:GULLoggerLevelError
+                                                             timestamp:1
+                                                             subsystem:@"subsystem"
+                                                              category:@"category"
+                                                           messageCode:@"I-TST000001"
+                                                               message:@"Message."
+                                                                fields:fields] ]];
+
+  GULLoggerSinkRecord *record =
+      [GULLoggerFileSink recordsInFileAtPath:fileSink.filePaths.firstObject error:NULL].firstObject;
+  XCTAssertEqualObjects(record.fields[@"status"], @503);
+  XCTAssertEqualObjects(record.fields[@"seconds"], @1.5);
+  XCTAssertEqualObjects(record.fields[@"path"], @"/v1/items");
+  XCTAssertEqualObjects(record.fields[@"etag"], [NSNull null]);
+  NSError *error = record.fields[@"error"];
+  XCTAssertEqualObjects(error.domain, @"GULTestDomain");
+  XCTAssertEqual(error.code, -7);
+  XCTAssertEqualObjects(error.localizedDescription, @"Failed.");
+  [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+@end
@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/Logger/GULLoggerRateLimiter.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+
+@interface GULLoggerRateLimiterTest : XCTestCase
+@end
+
+@implementation GULLoggerRateLimiterTest
+
+- (void)tearDown {
+  GULLoggerRemoveRateLimit(@"I-TST");
+  GULLoggerRemoveRateLimit(@"I-TST0001");
+  [super tearDown];
+}
+
+- (void)testBurstIsLoggedThenSuppressed {
+  GULLoggerSetRateLimit(@"I-TST", 0, 3);
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+
+  // Each code has its own bucket, and codes without a limit are never suppressed.
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000002"));
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-COR000001"));
+}
+
+- (void)testTokensRefill {
+  GULLoggerSetRateLimit(@"I-TST", 1000, 1);
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  [NSThread sleepForTimeInterval:0.01];
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+}
+
+- (void)testLongestPrefixApplies {
+  GULLoggerSetRateLimit(@"I-TST", 0, 0);
+  GULLoggerSetRateLimit(@"I-TST0001", 0, 1);
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000100"));
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000100"));
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000200"));
+}
+
+- (void)testChangingTheLimitStartsTheBucketOver {
+  GULLoggerSetRateLimit(@"I-TST", 0, 1);
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+
+  GULLoggerSetRateLimit(@"I-TST", 0, 2);
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+}
+
+- (void)testRemovingTheLimitStopsSuppression {
+  GULLoggerSetRateLimit(@"I-TST", 0, 0);
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+  GULLoggerRemoveRateLimit(@"I-TST");
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(@"I-TST000001"));
+}
+
+- (void)testSummaryIsNeverSuppressed {
+  GULLoggerSetRateLimit(@"I-COR", 0, 0);
+  XCTAssertFalse(GULLoggerRateLimiterShouldLog(@"I-COR000001"));
+  XCTAssertTrue(GULLoggerRateLimiterShouldLog(kGULLoggerRateLimitSummaryMessageCode));
+  GULLoggerRemoveRateLimit(@"I-COR");
+}
+
+@end
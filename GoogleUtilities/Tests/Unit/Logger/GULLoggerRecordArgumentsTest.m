@@ -0,0 +1,100 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/Logger/GULLoggerRecordArguments.h"
+
+/// Captures the arguments into a record and formats them from there. Returns nil if the arguments
+/// could not be captured.
+static NSString *GULDeferredFormat(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
+static NSString *GULDeferredFormat(NSString *format, ...) {
+  va_list args;
+  va_start(args, format);
+  GULLoggerRecord record = {0};
+  NSString *message = nil;
+  if (GULLoggerRecordCaptureArguments(&record, format, args)) {
+    message = GULLoggerRecordMessage(&record);
+  }
+  GULLoggerRecordReleaseArguments(&record);
+  va_end(args);
+  return message;
+}
+
+@interface GULLoggerRecordArgumentsTest : XCTestCase
+@end
+
+@implementation GULLoggerRecordArgumentsTest
+
+- (void)testFormatsLikeNSString {
+  XCTAssertEqualObjects(GULDeferredFormat(@"Configure %@ failed.", @"blah"),
+                        @"Configure blah failed.");
+  XCTAssertEqualObjects(GULDeferredFormat(@"%d %ld %lld %lu %zu %x %05.2f %c", -1, (long)-2,
+                                          (long long)INT64_MAX, (unsigned long)3, (size_t)4, 255,
+                                          3.14159, 'z'),
+                        ([NSString stringWithFormat:@"%d %ld %lld %lu %zu %x %05.2f %c", -1,
+                                                    (long)-2, (long long)INT64_MAX,
+                                                    (unsigned long)3, (size_t)4, 255, 3.14159,
+                                                    'z']));
+  XCTAssertEqualObjects(GULDeferredFormat(@"%s and %.3s", "C string", "truncated"),
+                        @"C string and tru");
+  XCTAssertEqualObjects(GULDeferredFormat(@"100%% of %@", nil), @"100% of (null)");
+  XCTAssertEqualObjects(GULDeferredFormat(@"Only literal text, 50%% off"),
+                        @"Only literal text, 50% off");
+}
+
+- (void)testUnsupportedFormatsAreNotCaptured {
+  XCTAssertNil(GULDeferredFormat(@"%*d", 4, 2));
+  XCTAssertNil(GULDeferredFormat(@"%2$@ %1$@", @"a", @"b"));
+  XCTAssertNil(GULDeferredFormat(@"%Lf", (long double)1));
+
+  // Arguments that do not fit in a record.
+  XCTAssertNil(GULDeferredFormat(@"%s", "a C string too long to fit into the argument area"));
+  XCTAssertNil(GULDeferredFormat(@"%f %f %f %f %f %f", 1.0, 2.0, 3.0, 4.0, 5.0, 6.0));
+}
+
+- (void)testCapturedObjectsAreRetainedUntilReleased {
+  GULLoggerRecord record = {0};
+  __weak NSObject *weakObject;
+  @autoreleasepool {
+    NSObject *object = [[NSObject alloc] init];
+    weakObject = object;
+    XCTAssertTrue([self captureIntoRecord:&record format:@"%@", object]);
+  }
+  XCTAssertNotNil(weakObject);
+  XCTAssertEqualObjects(GULLoggerRecordMessage(&record), weakObject.description);
+
+  GULLoggerRecordReleaseArguments(&record);
+  XCTAssertNil(weakObject);
+  XCTAssert(record.arguments == NULL);
+}
+
+- (void)testPrecisionBoundsCStringArguments {
+  // Not NUL-terminated, as `%.4s` allows.
+  char bytes[] = {'a', 'b', 'c', 'd'};
+  XCTAssertEqualObjects(GULDeferredFormat(@"[%.4s]", bytes), @"[abcd]");
+  XCTAssertEqualObjects(GULDeferredFormat(@"[%.2s]", bytes), @"[ab]");
+  XCTAssertEqualObjects(GULDeferredFormat(@"[%.100s]", "short"), @"[short]");
+  XCTAssertNil(GULDeferredFormat(@"%.*s", 4, bytes));
+}
+
+- (BOOL)captureIntoRecord:(GULLoggerRecord *)record format:(NSString *)format, ... {
+  va_list args;
+  va_start(args, format);
+  BOOL captured = GULLoggerRecordCaptureArguments(record, format, args);
+  va_end(args);
+  return captured;
+}
+
+@end
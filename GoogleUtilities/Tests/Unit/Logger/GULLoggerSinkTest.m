@@ -0,0 +1,234 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <unistd.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerFileSink.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerSink.h"
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerStderrSink.h"
+#import "GoogleUtilities/Tests/Unit/Logger/GULLoggerTestSink.h"
+
+extern dispatch_queue_t getGULClientQueue(void);
+
+static NSString *const kSubsystem = @"com.google.utilities.logger.test";
+static NSString *const kCategory = @"[GULLoggerSinkTest]";
+
+@interface GULLoggerSinkTest : XCTestCase
+@property(nonatomic) GULLoggerTestSink *sink;
+@property(nonatomic) NSString *directory;
+@end
+
+@implementation GULLoggerSinkTest
+
+- (void)setUp {
+  [super setUp];
+  // Write out messages logged by earlier tests before the sink is added.
+  GULLoggerFlush();
+  self.sink = [[GULLoggerTestSink alloc] init];
+  GULLoggerAddSink(self.sink);
+  self.directory =
+      [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+  GULLoggerRemoveSink(self.sink);
+  GULLoggerSetBufferPolicy(GULLoggerBufferPolicyDrop);
+  GULLoggerSetBufferCapacity(256);
+  [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+  [super tearDown];
+}
+
+- (GULLoggerSinkRecord *)recordWithMessage:(NSString *)message {
+  return [[GULLoggerSinkRecord alloc] initWithLevel:GULLoggerLevelWarning
+                                          timestamp:1767182400123000000
+                                          subsystem:kSubsystem
+                                           category:kCategory
+                                        messageCode:@"I-TST000001"
+                                            message:message];
+}
+
+- (void)testSinkReceivesLoggedMessages {
+  uint64_t loggedAfter = (uint64_t)([NSDate date].timeIntervalSince1970 * NSEC_PER_SEC);
+  GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000001", @"Configure %@ failed.", @"blah");
+  GULLoggerFlush();
+
+  XCTAssertEqual(self.sink.records.count, 1);
+  GULLoggerSinkRecord *record = self.sink.records.firstObject;
+  XCTAssertEqual(record.level, GULLoggerLevelError);
+  XCTAssertEqualObjects(record.subsystem, kSubsystem);
+  XCTAssertEqualObjects(record.category, kCategory);
+  XCTAssertEqualObjects(record.messageCode, @"I-TST000001");
+  XCTAssertEqualObjects(record.message, @"Configure blah failed.");
+  XCTAssertGreaterThanOrEqual(record.timestamp + NSEC_PER_MSEC, loggedAfter);
+  XCTAssertEqual(self.sink.flushCount, 1);
+}
+
+- (void)testRemovedSinkReceivesNothing {
+  GULLoggerRemoveSink(self.sink);
+  GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000001", @"Message.");
+  GULLoggerFlush();
+
+  XCTAssertEqual(self.sink.records.count, 0);
+}
+
+- (void)testMessagesLoggedBySinksAreNotPassedToSinks {
+  self.sink.logsFromWrite = YES;
+  GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000001", @"Message.");
+  GULLoggerFlush();
+
+  XCTAssertEqual(self.sink.records.count, 1);
+  XCTAssertEqualObjects(self.sink.records.firstObject.messageCode, @"I-TST000001");
+}
+
+- (void)testSinkLoggingFromAnotherQueueDoesNotWaitForItself {
+  GULLoggerSetBufferCapacity(2);
+  GULLoggerSetBufferPolicy(GULLoggerBufferPolicyBlock);
+  self.sink.logQueue = dispatch_queue_create("GULLoggerSinkTest", DISPATCH_QUEUE_SERIAL);
+
+  // The sink's messages go to the buffer of the thread that is draining, which would never make
+  // room while that thread waits for it.
+  dispatch_semaphore_t finished = dispatch_semaphore_create(0);
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000001", @"Message.");
+    GULLoggerFlush();
+    dispatch_semaphore_signal(finished);
+  });
+  XCTAssertEqual(
+      dispatch_semaphore_wait(finished, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+}
+
+- (void)testSinkFlushingFromWriteReceivesEveryRecordOnce {
+  self.sink.flushesFromWrite = YES;
+
+  // Hold the drain until more records are queued than fit into one batch, so that the sink flushes
+  // while the drain still has records to hand out.
+  dispatch_semaphore_t drainQueueBlocked = dispatch_semaphore_create(0);
+  dispatch_async(getGULClientQueue(), ^{
+    dispatch_semaphore_wait(drainQueueBlocked, DISPATCH_TIME_FOREVER);
+  });
+  // A new thread gets a buffer of the default capacity, which holds all of them.
+  dispatch_semaphore_t logged = dispatch_semaphore_create(0);
+  [[[NSThread alloc] initWithBlock:^{
+    for (int i = 0; i < 200; i++) {
+      GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000001", @"Message %d.", i);
+    }
+    dispatch_semaphore_signal(logged);
+  }] start];
+  dispatch_semaphore_wait(logged, DISPATCH_TIME_FOREVER);
+  dispatch_semaphore_signal(drainQueueBlocked);
+  GULLoggerFlush();
+
+  XCTAssertEqual(self.sink.records.count, 200);
+  for (NSUInteger i = 0; i < MIN(self.sink.records.count, 200); i++) {
+    NSString *message = [NSString stringWithFormat:@"Message %lu.", (unsigned long)i];
+    XCTAssertEqualObjects(self.sink.records[i].message, message);
+  }
+  XCTAssertGreaterThan(self.sink.flushCount, 1);
+}
+
+- (void)testFileSinkRoundTrip {
+  NSError *error;
+  GULLoggerFileSink *fileSink = [[GULLoggerFileSink alloc] initWithDirectory:self.directory
+                                                             maximumFileSize:0
+                                                            maximumFileCount:2
+                                                                       error:&error];
+  XCTAssertNotNil(fileSink, @"%@", error);
+  [fileSink writeRecords:@[
+    [self recordWithMessage:@"First"], [self recordWithMessage:@"Ünïcode"]
+  ]];
+  [fileSink flush];
+
+  // The file is read while it is still mapped and has its full size.
+  XCTAssertEqual(fileSink.filePaths.count, 1);
+  NSArray<GULLoggerSinkRecord *> *records =
+      [GULLoggerFileSink recordsInFileAtPath:fileSink.filePaths.firstObject error:&error];
+  XCTAssertEqual(records.count, 2, @"%@", error);
+  XCTAssertEqual(records[0].level, GULLoggerLevelWarning);
+  XCTAssertEqual(records[0].timestamp, 1767182400123000000);
+  XCTAssertEqualObjects(records[0].subsystem, kSubsystem);
+  XCTAssertEqualObjects(records[0].category, kCategory);
+  XCTAssertEqualObjects(records[0].messageCode, @"I-TST000001");
+  XCTAssertEqualObjects(records[0].message, @"First");
+  XCTAssertEqualObjects(records[1].message, @"Ünïcode");
+}
+
+- (void)testFileSinkWritesUnconvertibleMessagesAsEmpty {
+  GULLoggerFileSink *fileSink = [[GULLoggerFileSink alloc] initWithDirectory:self.directory
+                                                             maximumFileSize:0
+                                                            maximumFileCount:1
+                                                                       error:NULL];
+  // A lone surrogate has no UTF-8 representation.
+  unichar loneSurrogate = 0xD800;
+  NSString *message = [NSString stringWithCharacters:&loneSurrogate length:1];
+  [fileSink writeRecords:@[ [self recordWithMessage:message], [self recordWithMessage:@"Next"] ]];
+
+  NSArray<GULLoggerSinkRecord *> *records =
+      [GULLoggerFileSink recordsInFileAtPath:fileSink.filePaths.firstObject error:NULL];
+  XCTAssertEqual(records.count, 2);
+  XCTAssertEqualObjects(records[0].message, @"");
+  XCTAssertEqualObjects(records[1].message, @"Next");
+}
+
+- (void)testFileSinkRotatesAndDeletesOldestFiles {
+  NSUInteger pageSize = (NSUInteger)getpagesize();
+  GULLoggerFileSink *fileSink = [[GULLoggerFileSink alloc] initWithDirectory:self.directory
+                                                             maximumFileSize:pageSize
+                                                            maximumFileCount:2
+                                                                       error:NULL];
+  NSString *message = [@"" stringByPaddingToLength:pageSize / 3 withString:@"x" startingAtIndex:0];
+  for (int i = 0; i < 6; i++) {
+    [fileSink writeRecords:@[ [self recordWithMessage:message] ]];
+  }
+  // Too large for any file.
+  NSString *largeMessage = [message stringByPaddingToLength:pageSize
+                                                 withString:@"x"
+                                            startingAtIndex:0];
+  [fileSink writeRecords:@[ [self recordWithMessage:largeMessage] ]];
+
+  // Two records fit in each file, so six records need three files, of which two are kept.
+  NSArray<NSString *> *filePaths = fileSink.filePaths;
+  XCTAssertEqual(filePaths.count, 2);
+  XCTAssertEqual([GULLoggerFileSink recordsInFileAtPath:filePaths[0] error:NULL].count, 2);
+  XCTAssertEqual([GULLoggerFileSink recordsInFileAtPath:filePaths[1] error:NULL].count, 2);
+  XCTAssertEqual(fileSink.skippedRecordCount, 1);
+
+  // A new sink continues after the existing files.
+  fileSink = nil;
+  fileSink = [[GULLoggerFileSink alloc] initWithDirectory:self.directory
+                                          maximumFileSize:pageSize
+                                         maximumFileCount:2
+                                                    error:NULL];
+  XCTAssertEqualObjects(fileSink.filePaths.firstObject, filePaths[1]);
+}
+
+- (void)testStderrSinkWritesLines {
+  int fds[2];
+  XCTAssertEqual(pipe(fds), 0);
+  GULLoggerStderrSink *stderrSink = [[GULLoggerStderrSink alloc] initWithFileDescriptor:fds[1]];
+  [stderrSink
+      writeRecords:@[ [self recordWithMessage:@"First"], [self recordWithMessage:@"Last"] ]];
+  close(fds[1]);
+
+  NSFileHandle *handle = [[NSFileHandle alloc] initWithFileDescriptor:fds[0] closeOnDealloc:YES];
+  NSString *output = [[NSString alloc] initWithData:[handle readDataToEndOfFile]
+                                           encoding:NSUTF8StringEncoding];
+  NSString *prefix = @"2025-12-31 12:00:00.123Z <Warning> "
+                     @"com.google.utilities.logger.test[GULLoggerSinkTest][I-TST000001] ";
+  XCTAssertEqualObjects(output, ([NSString stringWithFormat:@"%@First\n%@Last\n", prefix, prefix]));
+}
+
+@end
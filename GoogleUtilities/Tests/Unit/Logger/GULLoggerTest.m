@@ -18,6 +18,7 @@
 #import <OCMock/OCMock.h>
 #import <XCTest/XCTest.h>
 
+#import "GoogleUtilities/Logger/GULLoggerHandleInternal.h"
 #import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
 
 #import <asl.h>
@@ -33,6 +34,10 @@ extern os_log_type_t GULLoggerLevelToOSLogType(GULLoggerLevel level);
 
 static NSString *const kMessageCode = @"I-COR000001";
 
+static dispatch_time_t GULLoggerTestTimeout(double seconds) {
+  return dispatch_time(DISPATCH_TIME_NOW, (int64_t)(seconds * NSEC_PER_SEC));
+}
+
 @interface GULLoggerTest : XCTestCase
 
 @property(nonatomic) NSString *randomLogString;
@@ -59,6 +64,32 @@ static NSString *const kMessageCode = @"I-COR000001";
   [super tearDown];
 
   _defaults = nil;
+  GULLoggerSetBufferPolicy(GULLoggerBufferPolicyDrop);
+  GULLoggerSetBufferCapacity(256);
+  GULLoggerSetDeferredFormatting(NO);
+}
+
+/// Logs 10 messages on a new thread, which gets a new log buffer, and returns a semaphore that is
+/// signaled when it is done.
+- (dispatch_semaphore_t)logMessagesOnNewThread {
+  dispatch_semaphore_t finished = dispatch_semaphore_create(0);
+  NSThread *thread = [[NSThread alloc] initWithBlock:^{
+    for (int i = 0; i < 10; i++) {
+      GULOSLogError(@"com.my.service", @"My/Category", NO, kMessageCode, @"Message %d.", i);
+    }
+    dispatch_semaphore_signal(finished);
+  }];
+  [thread start];
+  return finished;
+}
+
+/// Keeps the logger's queue busy until the returned semaphore is signaled.
+- (dispatch_semaphore_t)blockLoggerQueue {
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  dispatch_async(getGULClientQueue(), ^{
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+  });
+  return semaphore;
 }
 
 - (void)testMessageCodeFormat {
@@ -140,5 +171,196 @@ static NSString *const kMessageCode = @"I-COR000001";
   XCTAssertEqual(loggerLevel, GULLoggerLevelNotice);
 }
 
+- (void)testRegisterHandleReturnsSameHandleForSameCategory {
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/Category");
+  XCTAssertEqual(GULLoggerRegisterHandle(@"com.my.service", @"My/Category"), handle);
+  XCTAssertEqual(GULLoggerRegisterHandle([@"com.my." stringByAppendingString:@"service"],
+                                         [@"My/" stringByAppendingString:@"Category"]),
+                 handle);
+  XCTAssertNotEqual(GULLoggerRegisterHandle(@"com.my.service", @"My/OtherCategory"), handle);
+  XCTAssertNotEqual(GULLoggerRegisterHandle(@"com.my.other", @"My/Category"), handle);
+  XCTAssertEqualObjects((__bridge NSString *)handle->category, @"My/Category");
+}
+
+- (void)testLoggingByNameRegistersBoundedNumberOfHandles {
+  // Earlier tests may have used up part of the cap already.
+  NSUInteger registered = 0;
+  for (NSUInteger i = 0; i <= kGULLoggerMaximumImplicitHandles; i++) {
+    NSString *category = [NSString stringWithFormat:@"My/DynamicCategory%lu", (unsigned long)i];
+    if (GULLoggerImplicitHandle(@"com.my.dynamic", category)) {
+      registered++;
+    }
+  }
+  XCTAssertLessThanOrEqual(registered, kGULLoggerMaximumImplicitHandles);
+  XCTAssert(GULLoggerImplicitHandle(@"com.my.dynamic", @"My/OneMoreCategory") == NULL);
+  XCTAssert(GULLoggerExistingHandle(@"com.my.dynamic", @"My/OneMoreCategory") == NULL);
+
+  // Messages for those categories are still written, and explicit registration still works.
+  XCTAssertNoThrow(GULOSLogError(@"com.my.dynamic", @"My/OneMoreCategory", NO, kMessageCode,
+                                 @"Message."));
+  GULLoggerFlush();
+  XCTAssert(GULLoggerRegisterHandle(@"com.my.dynamic", @"My/OneMoreCategory") != NULL);
+}
+
+- (void)testHandleLevelOverridesGlobalLevel {
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/LevelCategory");
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelNotice));
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelInfo));
+
+  GULLoggerHandleSetLevel(handle, GULLoggerLevelDebug);
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+  XCTAssertEqual(GULGetLoggerLevel(), GULLoggerLevelNotice);
+
+  GULLoggerHandleSetLevel(handle, GULLoggerLevelError);
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelError));
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelWarning));
+}
+
+- (void)testHandleFollowsGlobalLevel {
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/Category");
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+
+  GULSetLoggerLevel(GULLoggerLevelDebug);
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+
+  GULResetLogger();
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+}
+
+- (void)testCategoryLevelOverridesGlobalLevelForThatCategoryOnly {
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.service", @"My/DebugCategory"), 0);
+
+  GULLoggerSetCategoryLevel(@"com.my.service", @"My/DebugCategory", GULLoggerLevelDebug);
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.service", @"My/DebugCategory"),
+                 GULLoggerLevelDebug);
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.service", @"My/Category"), 0);
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.other", @"My/DebugCategory"), 0);
+  XCTAssertEqual(GULGetLoggerLevel(), GULLoggerLevelNotice);
+  XCTAssertFalse(GULIsLoggableLevel(GULLoggerLevelDebug));
+
+  // Handles for the category see the same level.
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/DebugCategory");
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+
+  GULLoggerClearCategoryLevel(@"com.my.service", @"My/DebugCategory");
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.service", @"My/DebugCategory"), 0);
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+}
+
+- (void)testResetLoggerClearsCategoryLevels {
+  GULLoggerSetCategoryLevel(@"com.my.service", @"My/ResetCategory", GULLoggerLevelDebug);
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/ResetCategory");
+  XCTAssertTrue(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+
+  GULResetLogger();
+  XCTAssertEqual(GULLoggerLevelOverride(@"com.my.service", @"My/ResetCategory"), 0);
+  XCTAssertFalse(GULLoggerHandleIsLoggable(handle, GULLoggerLevelDebug));
+}
+
+- (void)testCategoryLevelIsReadConcurrentlyWithUpdates {
+  dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+    for (int j = 0; j < 100; j++) {
+      if (i == 0) {
+        GULLoggerSetCategoryLevel(@"com.my.service", @"My/FlappingCategory",
+                                  j % 2 ? GULLoggerLevelDebug : GULLoggerLevelError);
+      } else {
+        int level = GULLoggerLevelOverride(@"com.my.service", @"My/FlappingCategory");
+        XCTAssert(level == 0 || level == GULLoggerLevelDebug || level == GULLoggerLevelError);
+      }
+    }
+  });
+  GULLoggerClearCategoryLevel(@"com.my.service", @"My/FlappingCategory");
+}
+
+- (void)testLogMacrosOnlyEvaluateArgumentsWhenLoggable {
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/Category");
+  __block int evaluations = 0;
+  int (^evaluate)(void) = ^{
+    return ++evaluations;
+  };
+
+  GUL_LOG_DEBUG(handle, NO, kMessageCode, @"Value %d.", evaluate());
+  GUL_LOG_INFO(handle, NO, kMessageCode, @"Value %d.", evaluate());
+  XCTAssertEqual(evaluations, 0);
+
+  GUL_LOG_ERROR(handle, NO, kMessageCode, @"Value %d.", evaluate());
+  GUL_LOG_DEBUG(handle, YES, kMessageCode, @"Value %d.", evaluate());
+  XCTAssertEqual(evaluations, 2);
+
+  GULSetLoggerLevel(GULLoggerLevelDebug);
+  GUL_LOG_DEBUG(handle, NO, kMessageCode, @"Value %d.", evaluate());
+  XCTAssertEqual(evaluations, 3);
+  GULLoggerFlush();
+}
+
+- (void)testHandleLogChecksMessageCodeFormat {
+  GULLoggerHandle *handle = GULLoggerRegisterHandle(@"com.my.service", @"My/Category");
+  XCTAssertNoThrow(GULLoggerLogError(handle, NO, @"I-APP000001", @"Message %d.", 1));
+  XCTAssertThrows(GULLoggerLogError(handle, NO, @"I-APP-000001", @"Message."));
+  GULLoggerFlush();
+}
+
+- (void)testMessagesFromManyThreadsAreNotDropped {
+  uint64_t droppedCount = GULLoggerDroppedRecordCount();
+  dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+    for (int j = 0; j < 32; j++) {
+      GULOSLogError(@"com.my.service", @"My/Category", NO, kMessageCode, @"Message %d.", j);
+    }
+  });
+  GULLoggerFlush();
+  XCTAssertEqual(GULLoggerDroppedRecordCount(), droppedCount);
+}
+
+- (void)testFullBufferDropsMessages {
+  GULLoggerSetBufferCapacity(4);
+  uint64_t droppedCount = GULLoggerDroppedRecordCount();
+  dispatch_semaphore_t semaphore = [self blockLoggerQueue];
+
+  dispatch_semaphore_t finished = [self logMessagesOnNewThread];
+  XCTAssertEqual(dispatch_semaphore_wait(finished, GULLoggerTestTimeout(1)), 0);
+  XCTAssertEqual(GULLoggerDroppedRecordCount() - droppedCount, 6);
+
+  dispatch_semaphore_signal(semaphore);
+  GULLoggerFlush();
+}
+
+- (void)testFullBufferBlocksUnderBlockPolicy {
+  GULLoggerSetBufferCapacity(4);
+  GULLoggerSetBufferPolicy(GULLoggerBufferPolicyBlock);
+  uint64_t droppedCount = GULLoggerDroppedRecordCount();
+  dispatch_semaphore_t semaphore = [self blockLoggerQueue];
+
+  dispatch_semaphore_t finished = [self logMessagesOnNewThread];
+  XCTAssertNotEqual(dispatch_semaphore_wait(finished, GULLoggerTestTimeout(0.2)), 0);
+
+  dispatch_semaphore_signal(semaphore);
+  XCTAssertEqual(dispatch_semaphore_wait(finished, GULLoggerTestTimeout(1)), 0);
+  XCTAssertEqual(GULLoggerDroppedRecordCount(), droppedCount);
+}
+
+- (void)testDeferredFormattingReleasesArgumentsWhenWritten {
+  GULLoggerSetDeferredFormatting(YES);
+  __weak NSObject *weakObject;
+  @autoreleasepool {
+    NSObject *object = [[NSObject alloc] init];
+    weakObject = object;
+    GULOSLogError(@"com.my.service", @"My/Category", NO, kMessageCode, @"Object %@, %d.", object,
+                  1);
+  }
+  GULLoggerFlush();
+  XCTAssertNil(weakObject);
+}
+
+- (void)testLoggingFromLoggerQueueDoesNotWait {
+  GULLoggerSetBufferCapacity(2);
+  GULLoggerSetBufferPolicy(GULLoggerBufferPolicyBlock);
+  dispatch_sync(getGULClientQueue(), ^{
+    for (int i = 0; i < 10; i++) {
+      GULOSLogError(@"com.my.service", @"My/Category", NO, kMessageCode, @"Message %d.", i);
+    }
+    GULLoggerFlush();
+  });
+}
+
 @end
 #endif
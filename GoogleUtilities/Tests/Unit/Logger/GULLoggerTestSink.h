@@ -0,0 +1,34 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLoggerSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Collects the records it is passed, and optionally logs a message of its own for each batch.
+@interface GULLoggerTestSink : NSObject <GULLoggerSink>
+@property(nonatomic, readonly) NSMutableArray<GULLoggerSinkRecord *> *records;
+@property(nonatomic, readonly) NSUInteger flushCount;
+@property(nonatomic) BOOL logsFromWrite;
+/// Whether each batch calls `GULLoggerFlush` before returning.
+@property(nonatomic) BOOL flushesFromWrite;
+/// If set, the next batch logs ten messages from a `dispatch_sync` onto this queue.
+@property(nonatomic, nullable) dispatch_queue_t logQueue;
+@end
+
+NS_ASSUME_NONNULL_END
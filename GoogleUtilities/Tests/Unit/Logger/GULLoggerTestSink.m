@@ -0,0 +1,57 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleUtilities/Tests/Unit/Logger/GULLoggerTestSink.h"
+
+#import "GoogleUtilities/Logger/Public/GoogleUtilities/GULLogger.h"
+
+static NSString *const kSubsystem = @"com.google.utilities.logger.test";
+static NSString *const kCategory = @"[GULLoggerTestSink]";
+
+@implementation GULLoggerTestSink
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _records = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)writeRecords:(NSArray<GULLoggerSinkRecord *> *)records {
+  [self.records addObjectsFromArray:records];
+  if (self.logsFromWrite) {
+    GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000002", @"Logged by the sink.");
+  }
+  if (self.flushesFromWrite) {
+    GULLoggerFlush();
+  }
+  dispatch_queue_t logQueue = self.logQueue;
+  if (logQueue) {
+    self.logQueue = nil;
+    dispatch_sync(logQueue, ^{
+      for (int i = 0; i < 10; i++) {
+        GULOSLogError(kSubsystem, kCategory, YES, @"I-TST000003", @"Logged by the sink %d.", i);
+      }
+    });
+  }
+}
+
+- (void)flush {
+  _flushCount++;
+}
+
+@end
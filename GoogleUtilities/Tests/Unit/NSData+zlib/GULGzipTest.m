@@ -0,0 +1,298 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <fcntl.h>
+#import <zlib.h>
+
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULGzip.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+#import "GoogleUtilities/Tests/Unit/NSData+zlib/GULNSDataZlibTestPayload.h"
+
+@interface GULGzipTest : XCTestCase
+@end
+
+@implementation GULGzipTest
+
+/// Pushes `data` to the encoder in `chunkSize` pieces.
+- (NSData *)gzipData:(NSData *)data chunkSize:(NSUInteger)chunkSize windowSize:(NSUInteger)window {
+  NSMutableData *output = [NSMutableData data];
+  GULGzipEncoder *encoder = [[GULGzipEncoder alloc] initWithWindowSize:window
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           XCTAssertLessThanOrEqual(chunk.length,
+                                                                                    window);
+                                                           [output appendData:chunk];
+                                                           return YES;
+                                                         }];
+  for (NSUInteger offset = 0; offset < data.length; offset += chunkSize) {
+    NSUInteger length = MIN(chunkSize, data.length - offset);
+    NSError *error;
+    XCTAssertTrue([encoder appendBytes:(const char *)data.bytes + offset
+                                length:length
+                                 error:&error]);
+    XCTAssertNil(error);
+  }
+  XCTAssertTrue([encoder finishWithError:NULL]);
+  XCTAssertEqual(encoder.totalBytesIn, data.length);
+  XCTAssertEqual(encoder.totalBytesOut, output.length);
+  return output;
+}
+
+- (void)testEncoderOutputInflatesWithNSDataCategory {
+  NSData *payload = GULNSDataZlibTestPayload(300 * 1024);
+  NSData *compressed = [self gzipData:payload chunkSize:7 * 1024 windowSize:1024];
+
+  NSError *error;
+  NSData *inflated = [NSData gul_dataByInflatingGzippedData:compressed error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(inflated, payload);
+}
+
+- (void)testDecoderInflatesNSDataCategoryOutput {
+  NSData *payload = GULNSDataZlibTestPayload(300 * 1024);
+  NSData *compressed = [NSData gul_dataByGzippingData:payload error:NULL];
+
+  NSMutableData *output = [NSMutableData data];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:4096
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           XCTAssertLessThanOrEqual(chunk.length,
+                                                                                    4096);
+                                                           [output appendData:chunk];
+                                                           return YES;
+                                                         }];
+  // Feed one byte at a time to exercise every header and trailer boundary.
+  const char *bytes = compressed.bytes;
+  for (NSUInteger i = 0; i < compressed.length; i++) {
+    XCTAssertTrue([decoder appendBytes:bytes + i length:1 error:NULL]);
+  }
+  NSError *error;
+  XCTAssertTrue([decoder finishWithError:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(output, payload);
+  XCTAssertEqual(decoder.totalBytesIn, compressed.length);
+}
+
+- (void)testDecoderInflatesConcatenatedMembers {
+  NSData *first = GULNSDataZlibTestPayload(1000);
+  NSData *second = [@"second member" dataUsingEncoding:NSUTF8StringEncoding];
+  NSMutableData *compressed = [[NSData gul_dataByGzippingData:first error:NULL] mutableCopy];
+  [compressed appendData:[NSData gul_dataByGzippingData:second error:NULL]];
+
+  NSMutableData *output = [NSMutableData data];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           [output appendData:chunk];
+                                                           return YES;
+                                                         }];
+  XCTAssertTrue([decoder appendData:compressed error:NULL]);
+  XCTAssertTrue([decoder finishWithError:NULL]);
+
+  NSMutableData *expected = [first mutableCopy];
+  [expected appendData:second];
+  XCTAssertEqualObjects(output, expected);
+  XCTAssertEqual(decoder.totalBytesIn, compressed.length);
+}
+
+- (void)testDecoderCountsInputAcrossMembers {
+  NSMutableData *compressed = [NSMutableData data];
+  NSUInteger firstMemberLength = 0;
+  for (NSUInteger i = 0; i < 3; i++) {
+    [compressed appendData:[NSData gul_dataByGzippingData:GULNSDataZlibTestPayload(1000 * (i + 1))
+                                                    error:NULL]];
+    if (i == 0) {
+      firstMemberLength = compressed.length;
+    }
+  }
+
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return YES;
+                                                         }];
+  // The first member ends exactly at a call boundary and the second ends in the middle of a call,
+  // so both reset paths are taken.
+  NSRange firstRange = NSMakeRange(0, firstMemberLength);
+  NSRange restRange = NSMakeRange(firstMemberLength, compressed.length - firstMemberLength);
+  XCTAssertTrue([decoder appendData:[compressed subdataWithRange:firstRange] error:NULL]);
+  XCTAssertEqual(decoder.totalBytesIn, firstMemberLength);
+  XCTAssertTrue([decoder appendData:[compressed subdataWithRange:restRange] error:NULL]);
+  XCTAssertTrue([decoder finishWithError:NULL]);
+  XCTAssertEqual(decoder.totalBytesIn, compressed.length);
+  XCTAssertEqual(decoder.totalBytesOut, 6000);
+}
+
+- (void)testDecoderReportsIncompleteStream {
+  NSData *compressed = [NSData gul_dataByGzippingData:GULNSDataZlibTestPayload(1000) error:NULL];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return YES;
+                                                         }];
+  XCTAssertTrue([decoder appendData:[compressed subdataWithRange:NSMakeRange(0, 20)] error:NULL]);
+
+  NSError *error;
+  XCTAssertFalse([decoder finishWithError:&error]);
+  XCTAssertEqualObjects(error.domain, GULNSDataZlibErrorDomain);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorIncompleteStream);
+}
+
+- (void)testDecoderReportsCorruptData {
+  NSData *garbage = [@"this is not gzip data" dataUsingEncoding:NSUTF8StringEncoding];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return YES;
+                                                         }];
+  NSError *error;
+  XCTAssertFalse([decoder appendData:garbage error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+}
+
+- (void)testOutputHandlerFailureAbortsStream {
+  GULGzipEncoder *encoder = [[GULGzipEncoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return NO;
+                                                         }];
+  XCTAssertTrue([encoder appendData:GULNSDataZlibTestPayload(100) error:NULL]);
+
+  NSError *error;
+  XCTAssertFalse([encoder finishWithError:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorOutputWriteFailed);
+}
+
+- (void)testEncoderCannotBeUsedAfterFinish {
+  GULGzipEncoder *encoder = [[GULGzipEncoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return YES;
+                                                         }];
+  XCTAssertTrue([encoder finishWithError:NULL]);
+
+  NSError *error;
+  XCTAssertFalse([encoder appendData:GULNSDataZlibTestPayload(10) error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorStreamFinished);
+}
+
+- (void)testEncoderWritesToFileDescriptor {
+  NSString *path = [NSTemporaryDirectory()
+      stringByAppendingPathComponent:[NSString stringWithFormat:@"GULGzipTest-%@.gz",
+                                                                [NSUUID UUID].UUIDString]];
+  int fd = open(path.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  XCTAssertGreaterThanOrEqual(fd, 0);
+
+  NSData *payload = GULNSDataZlibTestPayload(200 * 1024);
+  GULGzipEncoder *encoder = [[GULGzipEncoder alloc] initWithWindowSize:512 fileDescriptor:fd];
+  XCTAssertTrue([encoder appendData:payload error:NULL]);
+  XCTAssertTrue([encoder finishWithError:NULL]);
+  close(fd);
+
+  NSData *compressed = [NSData dataWithContentsOfFile:path];
+  XCTAssertEqual(compressed.length, encoder.totalBytesOut);
+  XCTAssertEqualObjects([NSData gul_dataByInflatingGzippedData:compressed error:NULL], payload);
+  [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testDecoderWritesToOutputStream {
+  NSData *payload = GULNSDataZlibTestPayload(200 * 1024);
+  NSData *compressed = [NSData gul_dataByGzippingData:payload error:NULL];
+
+  NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+  [stream open];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0 outputStream:stream];
+  XCTAssertTrue([decoder appendData:compressed error:NULL]);
+  XCTAssertTrue([decoder finishWithError:NULL]);
+  [stream close];
+
+  XCTAssertEqualObjects([stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey], payload);
+}
+
+- (NSString *)temporaryPathWithExtension:(NSString *)extension {
+  NSString *name = [NSString stringWithFormat:@"GULGzipTest-%@.%@", [NSUUID UUID].UUIDString,
+                                              extension];
+  return [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+}
+
+- (void)testGzipFileToFileDescriptor {
+  // Larger than one mapped slice, so the source is compressed in several steps.
+  NSData *payload = GULNSDataZlibTestPayload(9 * 1024 * 1024 + 5);
+  NSString *sourcePath = [self temporaryPathWithExtension:@"log"];
+  NSString *destinationPath = [self temporaryPathWithExtension:@"gz"];
+  XCTAssertTrue([payload writeToFile:sourcePath atomically:NO]);
+  int fd = open(destinationPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  XCTAssertGreaterThanOrEqual(fd, 0);
+
+  uint64_t compressedSize = 0;
+  uint32_t crc = 0;
+  NSError *error;
+  XCTAssertTrue([GULGzipEncoder gzipFileAtPath:sourcePath
+                              toFileDescriptor:fd
+                                compressedSize:&compressedSize
+                                         crc32:&crc
+                                         error:&error]);
+  XCTAssertNil(error);
+  close(fd);
+
+  NSData *compressed = [NSData dataWithContentsOfFile:destinationPath];
+  XCTAssertEqual(compressed.length, compressedSize);
+  XCTAssertEqual(crc, (uint32_t)crc32(0, payload.bytes, (uInt)payload.length));
+  XCTAssertEqualObjects([NSData gul_dataByInflatingGzippedData:compressed error:NULL], payload);
+  [[NSFileManager defaultManager] removeItemAtPath:sourcePath error:NULL];
+  [[NSFileManager defaultManager] removeItemAtPath:destinationPath error:NULL];
+}
+
+- (void)testGzipEmptyFileWritesEmptyMember {
+  NSString *sourcePath = [self temporaryPathWithExtension:@"log"];
+  XCTAssertTrue([[NSData data] writeToFile:sourcePath atomically:NO]);
+
+  NSMutableData *output = [NSMutableData data];
+  int fds[2];
+  XCTAssertEqual(pipe(fds), 0);
+  uint64_t compressedSize = 0;
+  uint32_t crc = 1;
+  XCTAssertTrue([GULGzipEncoder gzipFileAtPath:sourcePath
+                              toFileDescriptor:fds[1]
+                                compressedSize:&compressedSize
+                                         crc32:&crc
+                                         error:NULL]);
+  close(fds[1]);
+  char buffer[64];
+  ssize_t bytesRead;
+  while ((bytesRead = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    [output appendBytes:buffer length:(NSUInteger)bytesRead];
+  }
+  close(fds[0]);
+
+  XCTAssertEqual(output.length, compressedSize);
+  XCTAssertEqual(crc, 0);
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           return YES;
+                                                         }];
+  XCTAssertTrue([decoder appendData:output error:NULL]);
+  XCTAssertTrue([decoder finishWithError:NULL]);
+  XCTAssertEqual(decoder.totalBytesOut, 0);
+  [[NSFileManager defaultManager] removeItemAtPath:sourcePath error:NULL];
+}
+
+- (void)testGzipMissingFileReportsReadError {
+  NSError *error;
+  XCTAssertFalse([GULGzipEncoder gzipFileAtPath:[self temporaryPathWithExtension:@"missing"]
+                               toFileDescriptor:STDOUT_FILENO
+                                 compressedSize:NULL
+                                          crc32:NULL
+                                          error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInputReadFailed);
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  XCTAssertEqualObjects(underlyingError.domain, NSPOSIXErrorDomain);
+  XCTAssertEqual(underlyingError.code, ENOENT);
+}
+
+@end
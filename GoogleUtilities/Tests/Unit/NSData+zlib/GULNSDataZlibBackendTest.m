@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <zlib.h>
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibBackend.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+#import "GoogleUtilities/Tests/Unit/NSData+zlib/GULNSDataZlibTestPayload.h"
+
+@interface GULNSDataZlibBackendTest : XCTestCase
+@end
+
+@implementation GULNSDataZlibBackendTest
+
+- (void)testBackendsInflateEachOther {
+  const GULNSDataZlibBackend *backends[] = {&GULNSDataZlibBackendZlib,
+                                            &GULNSDataZlibBackendCompression};
+  NSMutableData *random = [NSMutableData dataWithLength:10 * 1024];
+  arc4random_buf(random.mutableBytes, random.length);
+  NSArray<NSData *> *payloads =
+      @[ GULNSDataZlibTestPayload(1), GULNSDataZlibTestPayload(300 * 1024), random ];
+  for (NSData *payload in payloads) {
+    for (int i = 0; i < 2; i++) {
+      NSError *error;
+      NSData *compressed = backends[i]->gzip(payload, &error);
+      XCTAssertNil(error);
+      for (int j = 0; j < 2; j++) {
+        XCTAssertEqualObjects(backends[j]->inflate(compressed, &error), payload, @"%s -> %s",
+                              backends[i]->name, backends[j]->name);
+        XCTAssertNil(error);
+      }
+    }
+  }
+}
+
+- (void)testCompressionBackendFallsBackForZlibFraming {
+  NSData *payload = GULNSDataZlibTestPayload(10 * 1024);
+  uLongf compressedLength = compressBound(payload.length);
+  NSMutableData *compressed = [NSMutableData dataWithLength:compressedLength];
+  XCTAssertEqual(compress(compressed.mutableBytes, &compressedLength, payload.bytes,
+                          payload.length),
+                 Z_OK);
+  compressed.length = compressedLength;
+
+  XCTAssertEqualObjects(GULNSDataZlibBackendCompression.inflate(compressed, NULL), payload);
+}
+
+- (void)testCompressionBackendRejectsConcatenatedMembersLikeZlib {
+  NSData *member = [NSData gul_dataByGzippingData:GULNSDataZlibTestPayload(1000) error:NULL];
+  NSMutableData *compressed = [member mutableCopy];
+  [compressed appendData:member];
+
+  // The one-shot contract rejects data after the first member, like zlib does.
+  NSError *compressionError;
+  NSError *zlibError;
+  XCTAssertNil(GULNSDataZlibBackendCompression.inflate(compressed, &compressionError));
+  XCTAssertNil(GULNSDataZlibBackendZlib.inflate(compressed, &zlibError));
+  XCTAssertEqual(compressionError.code, GULNSDataZlibErrorDataRemaining);
+  XCTAssertEqualObjects(compressionError, zlibError);
+}
+
+- (void)testCompressionBackendReportsErrorsLikeZlib {
+  NSData *compressed = GULNSDataZlibBackendCompression.gzip(GULNSDataZlibTestPayload(1000), NULL);
+  NSData *truncated = [compressed subdataWithRange:NSMakeRange(0, compressed.length - 3)];
+  NSMutableData *corrupt = [compressed mutableCopy];
+  ((unsigned char *)corrupt.mutableBytes)[compressed.length - 6] ^= 0xff;
+
+  for (NSData *data in @[ truncated, corrupt ]) {
+    NSError *compressionError;
+    NSError *zlibError;
+    XCTAssertNil(GULNSDataZlibBackendCompression.inflate(data, &compressionError));
+    XCTAssertNil(GULNSDataZlibBackendZlib.inflate(data, &zlibError));
+    XCTAssertEqual(compressionError.code, GULNSDataZlibErrorInternal);
+    XCTAssertEqualObjects(compressionError, zlibError);
+  }
+}
+
+- (void)testCompressionBackendGrowsOutputBeyondTheTrustedSize {
+  // Past kGULNSDataZlibMaximumTrustedInflatedSize, the output is grown as the decoder fills it.
+  NSData *payload = GULNSDataZlibTestPayload(80 * 1024 * 1024);
+  NSData *compressed = GULNSDataZlibBackendCompression.gzip(payload, NULL);
+  XCTAssertEqualObjects(GULNSDataZlibBackendCompression.inflate(compressed, NULL), payload);
+
+  // A forged ISIZE is never reached, and the error is zlib's.
+  NSMutableData *random = [NSMutableData dataWithLength:128 * 1024];
+  arc4random_buf(random.mutableBytes, random.length);
+  NSMutableData *forged = [GULNSDataZlibBackendCompression.gzip(random, NULL) mutableCopy];
+  ((unsigned char *)forged.mutableBytes)[forged.length - 1] = 0x06;  // About 100 MB.
+  NSError *compressionError;
+  NSError *zlibError;
+  XCTAssertNil(GULNSDataZlibBackendCompression.inflate(forged, &compressionError));
+  XCTAssertNil(GULNSDataZlibBackendZlib.inflate(forged, &zlibError));
+  XCTAssertEqual(compressionError.code, GULNSDataZlibErrorInternal);
+  XCTAssertEqualObjects(compressionError, zlibError);
+}
+
+- (void)testEmptyDataReturnsNil {
+  XCTAssertNil(GULNSDataZlibBackendCompression.gzip([NSData data], NULL));
+  XCTAssertNil(GULNSDataZlibBackendCompression.inflate([NSData data], NULL));
+}
+
+@end
@@ -0,0 +1,334 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <fcntl.h>
+#import <unistd.h>
+#import <zlib.h>
+
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibBackend.h"
+#import "GoogleUtilities/NSData+zlib/GULNSDataZlibInternal.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULGzip.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+#import "GoogleUtilities/Tests/Unit/NSData+zlib/GULNSDataZlibTestPayload.h"
+
+@interface GULNSDataZlibTest : XCTestCase
+@end
+
+@implementation GULNSDataZlibTest
+
+- (void)tearDown {
+#ifdef DEBUG
+  GULNSDataZlibSetInputWindowForTesting(0);
+  GULNSDataZlibSetParallelBlockSizeForTesting(0);
+#endif
+  [super tearDown];
+}
+
+- (void)testGzipAndInflateRoundTrip {
+  NSData *payload = GULNSDataZlibTestPayload(100 * 1024);
+
+  NSError *error;
+  NSData *compressed = [NSData gul_dataByGzippingData:payload error:&error];
+  XCTAssertNil(error);
+  XCTAssertLessThan(compressed.length, payload.length);
+
+  NSData *inflated = [NSData gul_dataByInflatingGzippedData:compressed error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(inflated, payload);
+}
+
+- (void)testEmptyDataReturnsNil {
+  XCTAssertNil([NSData gul_dataByGzippingData:[NSData data] error:NULL]);
+  XCTAssertNil([NSData gul_dataByInflatingGzippedData:[NSData data] error:NULL]);
+}
+
+- (void)testInflateZlibWrappedData {
+  // zlib framing has no ISIZE trailer, so the output buffer starts from an estimate and grows.
+  NSData *payload = GULNSDataZlibTestPayload(100 * 1024);
+  uLongf compressedLength = compressBound(payload.length);
+  NSMutableData *compressed = [NSMutableData dataWithLength:compressedLength];
+  XCTAssertEqual(compress(compressed.mutableBytes, &compressedLength, payload.bytes,
+                          payload.length),
+                 Z_OK);
+  compressed.length = compressedLength;
+
+  NSError *error;
+  XCTAssertEqualObjects([NSData gul_dataByInflatingGzippedData:compressed error:&error], payload);
+  XCTAssertNil(error);
+}
+
+- (void)testInflateReportsTruncatedData {
+  NSData *compressed = [NSData gul_dataByGzippingData:GULNSDataZlibTestPayload(1000) error:NULL];
+  NSData *truncated = [compressed subdataWithRange:NSMakeRange(0, compressed.length - 3)];
+
+  NSError *error;
+  XCTAssertNil([NSData gul_dataByInflatingGzippedData:truncated error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+}
+
+- (void)testInflateReportsRemainingBytes {
+  NSMutableData *compressed =
+      [[NSData gul_dataByGzippingData:GULNSDataZlibTestPayload(1000) error:NULL] mutableCopy];
+  [compressed appendData:[@"trailing" dataUsingEncoding:NSUTF8StringEncoding]];
+
+  NSError *error;
+  XCTAssertNil([NSData gul_dataByInflatingGzippedData:compressed error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorDataRemaining);
+  XCTAssertEqualObjects(error.userInfo[GULNSDataZlibRemainingBytesKey], @8);
+}
+
+- (void)testForgedSizeTrailerDoesNotSizeTheOutput {
+  // Random bytes do not compress, so the member is large enough for a 100 MB ISIZE to look
+  // plausible.
+  NSMutableData *payload = [NSMutableData dataWithLength:128 * 1024];
+  arc4random_buf(payload.mutableBytes, payload.length);
+  NSMutableData *compressed = [[NSData gul_dataByGzippingData:payload error:NULL] mutableCopy];
+  XCTAssertEqual(GULNSDataZlibInflatedSizeHint(compressed.bytes, compressed.length),
+                 payload.length);
+
+  uint32_t forgedSize = 100 * 1024 * 1024;
+  unsigned char *isize = (unsigned char *)compressed.mutableBytes + compressed.length - 4;
+  for (int i = 0; i < 4; i++) {
+    isize[i] = (unsigned char)(forgedSize >> (8 * i));
+  }
+  XCTAssertEqual(GULNSDataZlibInflatedSizeHint(compressed.bytes, compressed.length),
+                 (NSUInteger)kGULNSDataZlibMaximumTrustedInflatedSize);
+
+  NSError *error;
+  XCTAssertNil([NSData gul_dataByInflatingGzippedData:compressed error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+}
+
+- (void)testDefaultOptionsMatchGzip {
+  NSData *payload = GULNSDataZlibTestPayload(10 * 1024);
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  XCTAssertEqualObjects([NSData gul_dataByDeflatingData:payload options:options error:NULL],
+                        GULNSDataZlibBackendZlib.gzip(payload, NULL));
+}
+
+- (void)testOptionsRoundTripInEveryFormatAndStrategy {
+  NSData *payload = GULNSDataZlibTestPayload(50 * 1024);
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  for (NSNumber *format in @[ @(GULNSDataZlibFormatGzip), @(GULNSDataZlibFormatZlib),
+                              @(GULNSDataZlibFormatRaw) ]) {
+    for (NSNumber *strategy in @[
+           @(GULNSDataZlibStrategyDefault), @(GULNSDataZlibStrategyFiltered),
+           @(GULNSDataZlibStrategyHuffmanOnly), @(GULNSDataZlibStrategyRLE)
+         ]) {
+      options.format = format.integerValue;
+      options.strategy = strategy.integerValue;
+      options.level = 1;
+
+      NSError *error;
+      NSData *compressed = [NSData gul_dataByDeflatingData:payload options:options error:&error];
+      XCTAssertNil(error);
+      NSData *inflated = [NSData gul_dataByInflatingData:compressed options:options error:&error];
+      XCTAssertEqualObjects(inflated, payload, @"format %@, strategy %@", format, strategy);
+      XCTAssertNil(error);
+    }
+  }
+}
+
+- (void)testPresetDictionaryShrinksSmallPayloads {
+  NSData *dictionary =
+      [@"{\"event\":\"screen_view\",\"params\":{\"screen_name\":\"\",\"engagement_time\":}}"
+          dataUsingEncoding:NSUTF8StringEncoding];
+  NSData *payload =
+      [@"{\"event\":\"screen_view\",\"params\":{\"screen_name\":\"home\",\"engagement_time\":42}}"
+          dataUsingEncoding:NSUTF8StringEncoding];
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  options.format = GULNSDataZlibFormatZlib;
+  NSData *plain = [NSData gul_dataByDeflatingData:payload options:options error:NULL];
+
+  for (NSNumber *format in @[ @(GULNSDataZlibFormatZlib), @(GULNSDataZlibFormatRaw) ]) {
+    options.format = format.integerValue;
+    options.dictionary = dictionary;
+    NSError *error;
+    NSData *compressed = [NSData gul_dataByDeflatingData:payload options:options error:&error];
+    XCTAssertNil(error);
+    XCTAssertLessThan(compressed.length, plain.length);
+    XCTAssertEqualObjects([NSData gul_dataByInflatingData:compressed options:options error:&error],
+                          payload);
+
+    // Inflating without the dictionary fails.
+    options.dictionary = nil;
+    XCTAssertNil([NSData gul_dataByInflatingData:compressed options:options error:&error]);
+    XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+  }
+}
+
+- (void)testLongPresetDictionaryIsNotTrimmed {
+  NSMutableData *dictionary = [NSMutableData dataWithLength:40 * 1024];
+  arc4random_buf(dictionary.mutableBytes, dictionary.length);
+  NSData *payload = [dictionary subdataWithRange:NSMakeRange(dictionary.length - 1000, 1000)];
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  options.format = GULNSDataZlibFormatZlib;
+  options.dictionary = dictionary;
+
+  NSError *error;
+  NSData *compressed = [NSData gul_dataByDeflatingData:payload options:options error:&error];
+  XCTAssertNil(error);
+
+  // The DICTID after the two header bytes identifies the whole dictionary, as a peer calling
+  // inflateSetDictionary with it expects.
+  const unsigned char *header = compressed.bytes;
+  uint32_t dictionaryID = ((uint32_t)header[2] << 24) | ((uint32_t)header[3] << 16) |
+                          ((uint32_t)header[4] << 8) | header[5];
+  XCTAssertEqual(dictionaryID,
+                 (uint32_t)adler32(adler32(0, NULL, 0), dictionary.bytes, (uInt)dictionary.length));
+  XCTAssertEqualObjects([NSData gul_dataByInflatingData:compressed options:options error:&error],
+                        payload);
+  XCTAssertNil(error);
+}
+
+- (void)testPresetDictionaryRequiresZlibOrRawFormat {
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  options.dictionary = [@"dictionary" dataUsingEncoding:NSUTF8StringEncoding];
+
+  NSError *error;
+  XCTAssertNil([NSData gul_dataByDeflatingData:GULNSDataZlibTestPayload(100)
+                                       options:options
+                                         error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+  XCTAssertEqualObjects(error.userInfo[GULNSDataZlibErrorKey], @(Z_STREAM_ERROR));
+}
+
+- (void)testInvalidLevelFails {
+  GULNSDataZlibOptions *options = [[GULNSDataZlibOptions alloc] init];
+  options.level = 10;
+
+  NSError *error;
+  XCTAssertNil([NSData gul_dataByDeflatingData:GULNSDataZlibTestPayload(100)
+                                       options:options
+                                         error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorInternal);
+}
+
+- (void)testConcurrentGzipProducesSingleMember {
+  NSData *payload = GULNSDataZlibTestPayload(1024 * 1024 + 17);
+
+  NSError *error;
+  NSData *compressed = [NSData gul_dataByGzippingData:payload concurrencyThreshold:0 error:&error];
+  XCTAssertNil(error);
+  NSData *serial = [NSData gul_dataByGzippingData:payload error:NULL];
+  XCTAssertNotEqualObjects(compressed, serial);
+  XCTAssertLessThan(compressed.length, serial.length + serial.length / 100);
+
+  // The one-shot inflate rejects data after the first member, so this also checks for one member.
+  XCTAssertEqualObjects([NSData gul_dataByInflatingGzippedData:compressed error:&error], payload);
+  XCTAssertNil(error);
+}
+
+- (void)testConcurrentGzipBelowThresholdIsSerial {
+  NSData *payload = GULNSDataZlibTestPayload(1024 * 1024);
+  XCTAssertEqualObjects([NSData gul_dataByGzippingData:payload
+                                  concurrencyThreshold:payload.length
+                                                 error:NULL],
+                        [NSData gul_dataByGzippingData:payload error:NULL]);
+}
+
+#ifdef DEBUG
+- (void)testConcurrentGzipWithSmallBlocks {
+  // Blocks smaller than the 32 KB dictionary, with random data that only matches within a block.
+  GULNSDataZlibSetParallelBlockSizeForTesting(1000);
+  NSMutableData *payload = [NSMutableData dataWithLength:300 * 1000 + 1];
+  arc4random_buf(payload.mutableBytes, payload.length);
+  [payload appendData:GULNSDataZlibTestPayload(200 * 1000)];
+
+  NSError *error;
+  NSData *compressed = [NSData gul_dataByGzippingData:payload concurrencyThreshold:0 error:&error];
+  XCTAssertNil(error);
+
+  NSMutableData *output = [NSMutableData data];
+  GULGzipDecoder *decoder = [[GULGzipDecoder alloc] initWithWindowSize:0
+                                                         outputHandler:^BOOL(NSData *chunk) {
+                                                           [output appendData:chunk];
+                                                           return YES;
+                                                         }];
+  XCTAssertTrue([decoder appendData:compressed error:&error]);
+  XCTAssertTrue([decoder finishWithError:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(output, payload);
+}
+
+- (void)testRoundTripFedInSmallInputWindows {
+  // Shrinking the input window exercises the same refill path that 64-bit payloads take.
+  GULNSDataZlibSetInputWindowForTesting(7);
+  NSData *payload = GULNSDataZlibTestPayload(64 * 1024);
+
+  NSError *error;
+  NSData *compressed = [NSData gul_dataByGzippingData:payload error:&error];
+  XCTAssertNil(error);
+  NSData *inflated = [NSData gul_dataByInflatingGzippedData:compressed error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(inflated, payload);
+
+  NSMutableData *padded = [compressed mutableCopy];
+  [padded appendBytes:"xyz" length:3];
+  XCTAssertNil([NSData gul_dataByInflatingGzippedData:padded error:&error]);
+  XCTAssertEqual(error.code, GULNSDataZlibErrorDataRemaining);
+  XCTAssertEqualObjects(error.userInfo[GULNSDataZlibRemainingBytesKey], @3);
+}
+#endif
+
+#if defined(__LP64__) && __LP64__
+- (void)testGzipMappedInputLargerThan4GB {
+  // Compressing 4 GB takes tens of seconds, so this only runs when asked for.
+  XCTSkipUnless(NSProcessInfo.processInfo.environment[@"GUL_RUN_LARGE_TESTS"].boolValue,
+                @"Set GUL_RUN_LARGE_TESTS=1 to gzip an input larger than 4 GB.");
+  // A sparse file of zeros is mapped instead of allocated, so the input never has to be resident.
+  unsigned long long length = (unsigned long long)UINT_MAX + 4097;
+  NSString *path = [NSTemporaryDirectory()
+      stringByAppendingPathComponent:[NSString stringWithFormat:@"GULNSDataZlibTest-%@",
+                                                                [NSUUID UUID].UUIDString]];
+  int fd = open(path.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  XCTAssertGreaterThanOrEqual(fd, 0);
+  XCTAssertEqual(ftruncate(fd, (off_t)length), 0);
+  close(fd);
+
+  NSError *error;
+  NSData *input = [NSData dataWithContentsOfFile:path
+                                         options:NSDataReadingMappedAlways
+                                           error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(input.length, length);
+
+  NSData *compressed = [NSData gul_dataByGzippingData:input error:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(compressed);
+  input = nil;
+  [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+
+  // Verify the output by streaming it, rather than inflating 4 GB into memory.
+  __block BOOL allZeros = YES;
+  GULGzipDecoder *decoder =
+      [[GULGzipDecoder alloc] initWithWindowSize:0
+                                   outputHandler:^BOOL(NSData *chunk) {
+                                     const unsigned char *bytes = chunk.bytes;
+                                     for (NSUInteger i = 0; i < chunk.length && allZeros; i++) {
+                                       allZeros = bytes[i] == 0;
+                                     }
+                                     return YES;
+                                   }];
+  XCTAssertTrue([decoder appendData:compressed error:&error]);
+  XCTAssertTrue([decoder finishWithError:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqual(decoder.totalBytesOut, length);
+  XCTAssertTrue(allZeros);
+}
+#endif
+
+@end
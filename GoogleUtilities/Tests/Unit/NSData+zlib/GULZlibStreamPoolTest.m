@@ -0,0 +1,125 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/NSData+zlib/GULZlibStreamPool.h"
+#import "GoogleUtilities/NSData+zlib/Public/GoogleUtilities/GULNSData+zlib.h"
+
+@interface GULZlibStreamPoolTest : XCTestCase
+@end
+
+@implementation GULZlibStreamPoolTest
+
+- (z_stream *)checkoutGzipStreamFromPool:(GULZlibStreamPool *)pool level:(int)level {
+  int zlibError = Z_OK;
+  z_stream *stream = [pool checkoutDeflateStreamWithLevel:level
+                                               windowBits:15 + 16
+                                                 memLevel:8
+                                                 strategy:Z_DEFAULT_STRATEGY
+                                                zlibError:&zlibError];
+  XCTAssert(stream != NULL);
+  XCTAssertEqual(zlibError, Z_OK);
+  return stream;
+}
+
+- (void)testCheckedInStreamIsReused {
+  GULZlibStreamPool *pool = [[GULZlibStreamPool alloc] initWithMaximumIdleStreams:2];
+  z_stream *stream = [self checkoutGzipStreamFromPool:pool level:Z_DEFAULT_COMPRESSION];
+  [pool checkinStream:stream];
+  XCTAssertEqual(pool.idleStreamCount, 1);
+
+  XCTAssertEqual([self checkoutGzipStreamFromPool:pool level:Z_DEFAULT_COMPRESSION], stream);
+  XCTAssertEqual(pool.idleStreamCount, 0);
+  [pool checkinStream:stream];
+}
+
+- (void)testStreamsAreMatchedByParameters {
+  GULZlibStreamPool *pool = [[GULZlibStreamPool alloc] initWithMaximumIdleStreams:2];
+  z_stream *fastest = [self checkoutGzipStreamFromPool:pool level:1];
+  [pool checkinStream:fastest];
+
+  z_stream *best = [self checkoutGzipStreamFromPool:pool level:9];
+  XCTAssertNotEqual(best, fastest);
+
+  int zlibError = Z_OK;
+  z_stream *inflate = [pool checkoutInflateStreamWithWindowBits:15 + 32 zlibError:&zlibError];
+  XCTAssertNotEqual(inflate, fastest);
+  XCTAssertEqual(pool.idleStreamCount, 1);
+
+  [pool checkinStream:best];
+  [pool checkinStream:inflate];
+}
+
+- (void)testIdleStreamsAreBounded {
+  GULZlibStreamPool *pool = [[GULZlibStreamPool alloc] initWithMaximumIdleStreams:2];
+  z_stream *streams[3];
+  for (int i = 0; i < 3; i++) {
+    streams[i] = [self checkoutGzipStreamFromPool:pool level:Z_DEFAULT_COMPRESSION];
+  }
+  for (int i = 0; i < 3; i++) {
+    [pool checkinStream:streams[i]];
+  }
+  XCTAssertEqual(pool.idleStreamCount, 2);
+
+  [pool trim];
+  XCTAssertEqual(pool.idleStreamCount, 0);
+}
+
+- (void)testSharedPoolKeepsAStreamPerActiveProcessor {
+  XCTAssertGreaterThanOrEqual([GULZlibStreamPool sharedPool].maximumIdleStreams,
+                              [NSProcessInfo processInfo].activeProcessorCount);
+}
+
+- (void)testStreamLeftMidwayIsResetOnCheckin {
+  GULZlibStreamPool *pool = [[GULZlibStreamPool alloc] initWithMaximumIdleStreams:1];
+  z_stream *stream = [self checkoutGzipStreamFromPool:pool level:Z_DEFAULT_COMPRESSION];
+  unsigned char input[] = "abandoned";
+  unsigned char output[64];
+  stream->next_in = input;
+  stream->avail_in = sizeof(input);
+  stream->next_out = output;
+  stream->avail_out = sizeof(output);
+  XCTAssertEqual(deflate(stream, Z_NO_FLUSH), Z_OK);
+  [pool checkinStream:stream];
+
+  // The reused stream must start a fresh gzip member.
+  XCTAssertEqual([self checkoutGzipStreamFromPool:pool level:Z_DEFAULT_COMPRESSION], stream);
+  XCTAssertEqual(stream->total_in, 0);
+  XCTAssertEqual(stream->avail_in, 0);
+  [pool checkinStream:stream];
+}
+
+- (void)testConcurrentGzipRoundTrips {
+  NSData *payload = [[@"concurrent " stringByPaddingToLength:64 * 1024
+                                                  withString:@"payload "
+                                             startingAtIndex:0]
+      dataUsingEncoding:NSUTF8StringEncoding];
+  __block NSUInteger failures = 0;
+  NSObject *lock = [[NSObject alloc] init];
+  dispatch_apply(64, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+    NSData *compressed = [NSData gul_dataByGzippingData:payload error:NULL];
+    NSData *inflated = [NSData gul_dataByInflatingGzippedData:compressed error:NULL];
+    if (![inflated isEqualToData:payload]) {
+      @synchronized(lock) {
+        failures++;
+      }
+    }
+  });
+  XCTAssertEqual(failures, 0);
+  XCTAssertLessThanOrEqual([GULZlibStreamPool sharedPool].idleStreamCount,
+                           [GULZlibStreamPool sharedPool].maximumIdleStreams);
+}
+
+@end
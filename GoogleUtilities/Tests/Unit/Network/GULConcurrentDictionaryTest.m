@@ -0,0 +1,102 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/Network/Public/GoogleUtilities/GULConcurrentDictionary.h"
+
+@interface GULConcurrentDictionaryTest : XCTestCase
+@property(nonatomic) GULConcurrentDictionary *dictionary;
+@end
+
+@implementation GULConcurrentDictionaryTest
+
+- (void)setUp {
+  [super setUp];
+  self.dictionary = [[GULConcurrentDictionary alloc] init];
+}
+
+- (void)tearDown {
+  self.dictionary = nil;
+  [super tearDown];
+}
+
+- (void)testStripeCount {
+  XCTAssertEqual([[GULConcurrentDictionary alloc] initWithStripeCount:0].stripeCount, 1);
+  XCTAssertEqual([[GULConcurrentDictionary alloc] initWithStripeCount:5].stripeCount, 8);
+  XCTAssertEqual([[GULConcurrentDictionary alloc] initWithStripeCount:100000].stripeCount, 1024);
+  XCTAssertGreaterThanOrEqual(self.dictionary.stripeCount,
+                              [NSProcessInfo processInfo].activeProcessorCount * 2);
+}
+
+- (void)testSetGetAndRemove {
+  XCTAssertNil([self.dictionary objectForKey:@"key"]);
+  [self.dictionary setObject:@"value" forKey:@"key"];
+  XCTAssertEqualObjects([self.dictionary objectForKey:@"key"], @"value");
+  [self.dictionary removeObjectForKey:@"key"];
+  XCTAssertNil([self.dictionary objectForKey:@"key"]);
+}
+
+- (void)testSetGetAndRemoveKeyed {
+  self.dictionary[@"key"] = @"value";
+  XCTAssertEqualObjects(self.dictionary[@"key"], @"value");
+  self.dictionary[@"key"] = nil;
+  XCTAssertNil(self.dictionary[@"key"]);
+}
+
+- (void)testCountDictionaryAndRemoveAll {
+  for (NSUInteger i = 0; i < 100; i++) {
+    self.dictionary[@(i)] = @(i * 2);
+  }
+  XCTAssertEqual(self.dictionary.count, 100);
+  NSDictionary *dictionary = self.dictionary.dictionary;
+  XCTAssertEqual(dictionary.count, 100);
+  XCTAssertEqualObjects(dictionary[@42], @84);
+
+  [self.dictionary removeAllObjects];
+  XCTAssertEqual(self.dictionary.count, 0);
+  XCTAssertEqualObjects(self.dictionary.dictionary, @{});
+}
+
+- (void)testEnumerationMayWriteAndStop {
+  for (NSUInteger i = 0; i < 100; i++) {
+    self.dictionary[@(i)] = @(i);
+  }
+  __block NSUInteger visitedCount = 0;
+  [self.dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+    XCTAssertEqualObjects(key, object);
+    [self.dictionary removeObjectForKey:key];
+    visitedCount++;
+    *stop = visitedCount == 60;
+  }];
+  XCTAssertEqual(visitedCount, 60);
+  XCTAssertEqual(self.dictionary.count, 40);
+}
+
+- (void)testConcurrentWrites {
+  GULConcurrentDictionary *dictionary = self.dictionary;
+  dispatch_apply(16, DISPATCH_APPLY_AUTO, ^(size_t thread) {
+    for (NSUInteger i = 0; i < 1000; i++) {
+      NSNumber *key = @(thread * 1000 + i);
+      dictionary[key] = key;
+      XCTAssertEqualObjects(dictionary[key], key);
+      if (i % 2) {
+        [dictionary removeObjectForKey:key];
+      }
+    }
+  });
+  XCTAssertEqual(dictionary.count, 8000);
+}
+
+@end
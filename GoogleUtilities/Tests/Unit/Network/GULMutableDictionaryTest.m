@@ -21,6 +21,19 @@ const static NSString *const kValue = @"testValue1";
 const static NSString *const kKey2 = @"testKey2";
 const static NSString *const kValue2 = @"testValue2";
 
+/// Reads the dictionary it is given when it is deallocated.
+@interface GULMutableDictionaryTestDeallocReader : NSObject
+@property(nonatomic, weak) GULMutableDictionary *dictionary;
+@end
+
+@implementation GULMutableDictionaryTestDeallocReader
+
+- (void)dealloc {
+  [self.dictionary count];
+}
+
+@end
+
 @interface GULMutableDictionaryTest : XCTestCase
 @property(nonatomic) GULMutableDictionary *dictionary;
 @end
@@ -84,4 +97,233 @@ const static NSString *const kValue2 = @"testValue2";
   XCTAssertEqual(dict[kKey2], kValue2);
 }
 
+- (void)testSnapshotIsSharedUntilNextWrite {
+  self.dictionary[kKey] = kValue;
+  NSDictionary *snapshot = self.dictionary.dictionary;
+  XCTAssertEqual(self.dictionary.dictionary, snapshot);
+
+  self.dictionary[kKey2] = kValue2;
+  [self.dictionary removeObjectForKey:kKey];
+  XCTAssertEqualObjects(snapshot, @{kKey : kValue});
+  XCTAssertNotEqual(self.dictionary.dictionary, snapshot);
+  XCTAssertEqualObjects(self.dictionary.dictionary, @{kKey2 : kValue2});
+}
+
+- (void)testSnapshotIsKeptByCompoundOperationsThatChangeNothing {
+  self.dictionary[kKey] = kValue;
+  NSDictionary *snapshot = self.dictionary.dictionary;
+
+  [self.dictionary objectForKey:kKey
+                       orInsert:^id {
+                         return kValue2;
+                       }];
+  XCTAssertFalse([self.dictionary compareAndSetObject:kValue forKey:kKey expectedObject:kValue2]);
+  [self.dictionary performBatchUpdates:^(NSMutableDictionary *objects) {
+    [objects removeObjectForKey:kKey2];
+  }];
+  XCTAssertEqual(self.dictionary.dictionary, snapshot);
+
+  [self.dictionary performBatchUpdates:^(NSMutableDictionary *objects) {
+    objects[kKey2] = kValue2;
+  }];
+  XCTAssertNotEqual(self.dictionary.dictionary, snapshot);
+}
+
+- (void)testSnapshotCanBeEnumeratedWhileWriting {
+  for (NSUInteger i = 0; i < 100; i++) {
+    self.dictionary[@(i)] = @(i);
+  }
+  for (NSNumber *key in self.dictionary.dictionary) {
+    [self.dictionary removeObjectForKey:key];
+  }
+  XCTAssertEqual(self.dictionary.count, 0);
+}
+
+- (void)testObjectForKeyOrInsert {
+  XCTAssertEqual([self.dictionary objectForKey:kKey
+                                      orInsert:^id {
+                                        return kValue;
+                                      }],
+                 kValue);
+  XCTAssertEqual([self.dictionary objectForKey:kKey
+                                      orInsert:^id {
+                                        XCTFail(@"Called for an existing object.");
+                                        return kValue2;
+                                      }],
+                 kValue);
+  XCTAssertNil([self.dictionary objectForKey:kKey2
+                                    orInsert:^id {
+                                      return nil;
+                                    }]);
+  XCTAssertEqual(self.dictionary.count, 1);
+}
+
+- (void)testObjectForKeyOrInsertCallsBlockOnce {
+  GULMutableDictionary *dictionary = self.dictionary;
+  __block NSUInteger callCount = 0;
+  dispatch_apply(100, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+    id object = [dictionary objectForKey:kKey
+                                orInsert:^id {
+                                  callCount++;
+                                  return kValue;
+                                }];
+    XCTAssertEqual(object, kValue);
+  });
+  XCTAssertEqual(callCount, 1);
+}
+
+- (void)testCompareAndSet {
+  XCTAssertFalse([self.dictionary compareAndSetObject:kValue forKey:kKey expectedObject:kValue2]);
+  XCTAssertNil(self.dictionary[kKey]);
+  XCTAssertTrue([self.dictionary compareAndSetObject:kValue forKey:kKey expectedObject:nil]);
+  XCTAssertEqual(self.dictionary[kKey], kValue);
+  XCTAssertFalse([self.dictionary compareAndSetObject:kValue2 forKey:kKey expectedObject:nil]);
+  XCTAssertTrue([self.dictionary compareAndSetObject:kValue2
+                                              forKey:kKey
+                                      expectedObject:[@"testValue1" mutableCopy]]);
+  XCTAssertEqual(self.dictionary[kKey], kValue2);
+  XCTAssertTrue([self.dictionary compareAndSetObject:nil forKey:kKey expectedObject:kValue2]);
+  XCTAssertEqual(self.dictionary.count, 0);
+}
+
+- (void)testRemoveObjectIfEqual {
+  self.dictionary[kKey] = kValue;
+  XCTAssertFalse([self.dictionary removeObjectForKey:kKey ifEqualTo:kValue2]);
+  XCTAssertEqual(self.dictionary[kKey], kValue);
+  XCTAssertTrue([self.dictionary removeObjectForKey:kKey ifEqualTo:kValue]);
+  XCTAssertNil(self.dictionary[kKey]);
+  XCTAssertFalse([self.dictionary removeObjectForKey:kKey ifEqualTo:kValue]);
+}
+
+- (void)testPerformBatchUpdates {
+  self.dictionary[kKey] = kValue;
+  NSDictionary *snapshot = self.dictionary.dictionary;
+  [self.dictionary performBatchUpdates:^(NSMutableDictionary *objects) {
+    XCTAssertEqual(objects[kKey], kValue);
+    [objects removeObjectForKey:kKey];
+    objects[kKey2] = kValue2;
+  }];
+  XCTAssertEqualObjects(self.dictionary.dictionary, @{kKey2 : kValue2});
+  XCTAssertEqualObjects(snapshot, @{kKey : kValue});
+}
+
+- (void)testObjectRemovedByBatchUpdatesMayReadDictionaryWhenDeallocated {
+  @autoreleasepool {
+    GULMutableDictionaryTestDeallocReader *reader =
+        [[GULMutableDictionaryTestDeallocReader alloc] init];
+    reader.dictionary = self.dictionary;
+    self.dictionary[kKey] = reader;
+  }
+  // Would deadlock if `reader` was deallocated while the dictionary is locked.
+  [self.dictionary performBatchUpdates:^(NSMutableDictionary *objects) {
+    [objects removeAllObjects];
+  }];
+  XCTAssertEqual(self.dictionary.count, 0);
+}
+
+- (void)testBurstOfWritesIsAppliedInOrder {
+  for (NSUInteger i = 0; i < 1000; i++) {
+    self.dictionary[@(i % 10)] = @(i);
+    if (i % 3 == 0) {
+      [self.dictionary removeObjectForKey:@(i % 10)];
+    }
+    if (i == 500) {
+      [self.dictionary removeAllObjects];
+    }
+  }
+  NSDictionary *expected = @{@1 : @991, @2 : @992, @4 : @994, @5 : @995, @7 : @997, @8 : @998};
+  XCTAssertEqualObjects(self.dictionary.dictionary, expected);
+}
+
+- (void)testNilObjectOrKeyIsIgnored {
+  self.dictionary[kKey] = kValue;
+  id nilObject = nil;
+  // setObject:forKey: also asserts, unless assertions are compiled out, so only the contents are
+  // checked.
+  @try {
+    [self.dictionary setObject:nilObject forKey:kKey2];
+  } @catch (NSException *exception) {
+  }
+  @try {
+    [self.dictionary setObject:kValue2 forKey:nilObject];
+  } @catch (NSException *exception) {
+  }
+  [self.dictionary removeObjectForKey:nilObject];
+  XCTAssertEqualObjects(self.dictionary.dictionary, @{kKey : kValue});
+}
+
+- (void)testSettingNilThroughSubscriptRemovesTheObject {
+  self.dictionary[kKey] = kValue;
+  self.dictionary[kKey2] = kValue2;
+  self.dictionary[kKey] = nil;
+  XCTAssertEqualObjects(self.dictionary.dictionary, @{kKey2 : kValue2});
+}
+
+- (void)testFlushAppliesWrites {
+  __weak NSObject *weakObject;
+  @autoreleasepool {
+    NSObject *object = [[NSObject alloc] init];
+    weakObject = object;
+    self.dictionary[kKey] = object;
+    [self.dictionary removeObjectForKey:kKey];
+    [self.dictionary flush];
+  }
+  XCTAssertNil(weakObject);
+}
+
+- (void)testConcurrentReadsAndWrites {
+  GULMutableDictionary *dictionary = self.dictionary;
+  dispatch_apply(1000, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+    NSNumber *key = @(iteration % 100);
+    if (iteration % 10 == 0) {
+      dictionary[key] = @(iteration);
+    } else {
+      NSNumber *object = dictionary[key];
+      XCTAssertTrue(object == nil || object.unsignedIntegerValue % 100 == iteration % 100);
+    }
+  });
+  XCTAssertEqual(dictionary.count, 10);
+}
+
+- (void)testReadSeesEarlierWriteFromAnotherThread {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"read"];
+  self.dictionary[kKey] = kValue;
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+    XCTAssertEqual(self.dictionary[kKey], kValue);
+    [expectation fulfill];
+  });
+  [self waitForExpectations:@[ expectation ] timeout:1];
+}
+
+@end
+
+@interface GULMutableDictionaryConcurrentReadsTest : GULMutableDictionaryTest
+@end
+
+@implementation GULMutableDictionaryConcurrentReadsTest
+
+- (void)setUp {
+  [super setUp];
+  self.dictionary = [[GULMutableDictionary alloc]
+      initWithConcurrency:GULMutableDictionaryConcurrencyConcurrentReads];
+}
+
+- (void)testConcurrency {
+  XCTAssertEqual(self.dictionary.concurrency, GULMutableDictionaryConcurrencyConcurrentReads);
+  XCTAssertEqual([[GULMutableDictionary alloc] init].concurrency,
+                 GULMutableDictionaryConcurrencySerial);
+}
+
+- (void)testRemovedObjectMayReadDictionaryWhenDeallocated {
+  @autoreleasepool {
+    GULMutableDictionaryTestDeallocReader *reader =
+        [[GULMutableDictionaryTestDeallocReader alloc] init];
+    reader.dictionary = self.dictionary;
+    self.dictionary[kKey] = reader;
+  }
+  // Would deadlock if `reader` was deallocated while the lock is held for writing.
+  [self.dictionary removeObjectForKey:kKey];
+  XCTAssertEqual(self.dictionary.count, 0);
+}
+
 @end
@@ -187,6 +187,41 @@
                                }];
 }
 
+- (void)testBackToBackRequestsShareSession_POST_foreground {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Expect blocks are called"];
+
+  NSData *uncompressedData = [@"Google" dataUsingEncoding:NSUTF8StringEncoding];
+  NSURL *url =
+      [NSURL URLWithString:[NSString stringWithFormat:@"http://localhost:%d/2", _httpServer.port]];
+  _statusCode = 200;
+
+  // The second request goes through the session that the first one completed on, which must not
+  // have been invalidated.
+  [_network postURL:url
+                     payload:uncompressedData
+                       queue:_backgroundQueue
+      usingBackgroundSession:NO
+           completionHandler:^(NSHTTPURLResponse *response, NSData *data, NSError *error) {
+             [self verifyResponse:response error:error];
+             [self->_network postURL:url
+                                 payload:uncompressedData
+                                   queue:self->_backgroundQueue
+                  usingBackgroundSession:NO
+                       completionHandler:^(NSHTTPURLResponse *secondResponse, NSData *secondData,
+                                           NSError *secondError) {
+                         [self verifyResponse:secondResponse error:secondError];
+                         XCTAssertNotNil(secondData);
+                         [expectation fulfill];
+                       }];
+           }];
+  [self waitForExpectationsWithTimeout:10
+                               handler:^(NSError *error) {
+                                 if (error) {
+                                   XCTFail(@"Timeout Error: %@", error);
+                                 }
+                               }];
+}
+
 - (void)testSessionNetworkShouldReturnError_POST_foreground {
   XCTestExpectation *expectation = [self expectationWithDescription:@"Expect block is called"];
 
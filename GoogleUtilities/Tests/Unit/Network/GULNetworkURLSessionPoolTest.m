@@ -0,0 +1,171 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleUtilities/Network/GULNetworkURLSessionPool.h"
+
+/// Records the task it completes with.
+@interface GULNetworkURLSessionPoolTestDelegate : NSObject <NSURLSessionDataDelegate,
+                                                            NSURLSessionDownloadDelegate>
+@property(nonatomic) XCTestExpectation *completion;
+@property(nonatomic) NSMutableArray<NSURLSessionTask *> *completedTasks;
+@end
+
+@implementation GULNetworkURLSessionPoolTestDelegate
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _completedTasks = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)URLSession:(NSURLSession *)session
+                 downloadTask:(NSURLSessionDownloadTask *)downloadTask
+    didFinishDownloadingToURL:(NSURL *)location {
+}
+
+- (void)URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+    didCompleteWithError:(NSError *)error {
+  [self.completedTasks addObject:task];
+  [self.completion fulfill];
+}
+
+@end
+
+@interface GULNetworkURLSessionPoolTest : XCTestCase
+@property(nonatomic) GULNetworkURLSessionPool *pool;
+@end
+
+@implementation GULNetworkURLSessionPoolTest
+
+- (void)setUp {
+  [super setUp];
+  self.pool = [[GULNetworkURLSessionPool alloc] initWithMaximumSessionCount:2];
+}
+
+- (void)tearDown {
+  [self.pool invalidateSessions];
+  self.pool = nil;
+  [super tearDown];
+}
+
+- (NSURLSessionConfiguration *)configurationWithTimeout:(NSTimeInterval)timeout {
+  NSURLSessionConfiguration *configuration =
+      [NSURLSessionConfiguration defaultSessionConfiguration];
+  configuration.timeoutIntervalForRequest = timeout;
+  configuration.timeoutIntervalForResource = timeout;
+  return configuration;
+}
+
+/// Returns the session the pool uses for `configuration`, without creating a task in it.
+- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration {
+  __block NSURLSession *pooledSession;
+  [self.pool taskWithConfiguration:configuration
+                          delegate:[[GULNetworkURLSessionPoolTestDelegate alloc] init]
+                  createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                    pooledSession = session;
+                    return nil;
+                  }];
+  return pooledSession;
+}
+
+- (void)testSessionIsSharedByEqualConfigurations {
+  NSURLSession *session = [self sessionWithConfiguration:[self configurationWithTimeout:10]];
+  XCTAssertEqual([self sessionWithConfiguration:[self configurationWithTimeout:10]], session);
+  XCTAssertEqual(session.delegateQueue, [NSOperationQueue mainQueue]);
+
+  NSURLSessionConfiguration *uncachedConfiguration = [self configurationWithTimeout:10];
+  uncachedConfiguration.URLCache = nil;
+  XCTAssertNotEqual([self sessionWithConfiguration:uncachedConfiguration], session);
+  XCTAssertNotEqual([self sessionWithConfiguration:[self configurationWithTimeout:20]], session);
+}
+
+- (void)testSessionIsSharedRegardlessOfAdditionalHeaders {
+  NSURLSession *session = [self sessionWithConfiguration:[self configurationWithTimeout:10]];
+  NSURLSessionConfiguration *configuration = [self configurationWithTimeout:10];
+  configuration.HTTPAdditionalHeaders = @{@"X-Test" : @"value"};
+  XCTAssertEqual([self sessionWithConfiguration:configuration], session);
+
+  configuration = [self configurationWithTimeout:30];
+  configuration.HTTPAdditionalHeaders = @{@"X-Test" : @"value"};
+  XCTAssertNil([self sessionWithConfiguration:configuration].configuration.HTTPAdditionalHeaders);
+}
+
+- (void)testLeastRecentlyUsedSessionIsEvicted {
+  NSURLSession *first = [self sessionWithConfiguration:[self configurationWithTimeout:1]];
+  NSURLSession *second = [self sessionWithConfiguration:[self configurationWithTimeout:2]];
+  XCTAssertEqual([self sessionWithConfiguration:[self configurationWithTimeout:1]], first);
+
+  // Evicts `second`, which was used less recently than `first`.
+  [self sessionWithConfiguration:[self configurationWithTimeout:3]];
+  XCTAssertEqual([self sessionWithConfiguration:[self configurationWithTimeout:1]], first);
+  XCTAssertNotEqual([self sessionWithConfiguration:[self configurationWithTimeout:2]], second);
+}
+
+- (void)testDelegateMethodsAreRoutedToTheDelegateOfTheTask {
+  NSURLSessionConfiguration *configuration = [self configurationWithTimeout:5];
+  // Nothing listens on the discard port of the loopback interface, so the tasks fail right away.
+  NSURL *URL = [NSURL URLWithString:@"http://127.0.0.1:9/"];
+
+  GULNetworkURLSessionPoolTestDelegate *firstDelegate =
+      [[GULNetworkURLSessionPoolTestDelegate alloc] init];
+  firstDelegate.completion = [self expectationWithDescription:@"first task"];
+  GULNetworkURLSessionPoolTestDelegate *secondDelegate =
+      [[GULNetworkURLSessionPoolTestDelegate alloc] init];
+  secondDelegate.completion = [self expectationWithDescription:@"second task"];
+  NSURLSessionTask *firstTask =
+      [self.pool taskWithConfiguration:configuration
+                              delegate:firstDelegate
+                      createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                        return [session dataTaskWithURL:URL];
+                      }];
+  NSURLSessionTask *secondTask =
+      [self.pool taskWithConfiguration:configuration
+                              delegate:secondDelegate
+                      createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                        return [session downloadTaskWithURL:URL];
+                      }];
+
+  [firstTask resume];
+  [secondTask resume];
+  [self waitForExpectationsWithTimeout:10 handler:nil];
+  XCTAssertEqualObjects(firstDelegate.completedTasks, @[ firstTask ]);
+  XCTAssertEqualObjects(secondDelegate.completedTasks, @[ secondTask ]);
+}
+
+- (void)testTaskOfEvictedSessionStillRuns {
+  GULNetworkURLSessionPoolTestDelegate *delegate =
+      [[GULNetworkURLSessionPoolTestDelegate alloc] init];
+  delegate.completion = [self expectationWithDescription:@"task"];
+  NSURL *URL = [NSURL URLWithString:@"http://127.0.0.1:9/"];
+  NSURLSessionTask *task =
+      [self.pool taskWithConfiguration:[self configurationWithTimeout:1]
+                              delegate:delegate
+                      createdWithBlock:^NSURLSessionTask *(NSURLSession *session) {
+                        return [session dataTaskWithURL:URL];
+                      }];
+
+  // Evicts the session of `task` before it is resumed.
+  [self sessionWithConfiguration:[self configurationWithTimeout:2]];
+  [self sessionWithConfiguration:[self configurationWithTimeout:3]];
+  [task resume];
+  [self waitForExpectationsWithTimeout:10 handler:nil];
+  XCTAssertEqualObjects(delegate.completedTasks, @[ task ]);
+}
+
+@end
@@ -147,6 +147,7 @@ let package = Package(
       ],
       linkerSettings: [
         .linkedLibrary("z"),
+        .linkedLibrary("compression"),
       ]
     ),
     .target(
@@ -231,6 +232,18 @@ let package = Package(
         .headerSearchPath("../../.."),
       ]
     ),
+    .testTarget(
+      name: "UtilitiesBenchmark",
+      dependencies: [
+        "GoogleUtilities-Logger",
+        "GoogleUtilities-Network",
+        "GoogleUtilities-NSData",
+      ],
+      path: "GoogleUtilities/Tests/Benchmark",
+      cSettings: [
+        .headerSearchPath("../../.."),
+      ]
+    ),
   ],
   cLanguageStandard: .c99,
   cxxLanguageStandard: CXXLanguageStandard.gnucxx14